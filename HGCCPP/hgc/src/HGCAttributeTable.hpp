@@ -0,0 +1,186 @@
+#ifndef SRC_HGC_ATTRIBUTE_TABLE_HPP_
+#define SRC_HGC_ATTRIBUTE_TABLE_HPP_
+
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+
+// the attributes data as dictionary encoded columns. every column stores one code per sample which indexes into the column's
+// dictionary of distinct values, so a categorical column with few values costs four bytes per sample and labels are gathered by code.
+class HGCAttributeTable {
+
+public:
+	static constexpr std::uint32_t missing = std::numeric_limits<std::uint32_t>::max();
+	static constexpr std::size_t notFound = std::numeric_limits<std::size_t>::max();
+
+	HGCAttributeTable();
+	virtual ~HGCAttributeTable();
+
+	std::size_t addSample(const std::string& sampleName);
+	std::size_t addColumn(const std::string& columnName);
+	void resizeColumns();
+	void set(std::size_t column, std::size_t sample, const std::string& value);
+
+	bool empty() const;
+	bool hasSample(const std::string& sampleName) const;
+	std::size_t findSample(const std::string& sampleName) const;
+	std::size_t findColumn(const std::string& columnName) const;
+	std::vector<std::uint32_t> gather(std::size_t column, const std::vector<std::size_t>& samples) const;
+	const std::vector<std::string>& getDictionary(std::size_t column) const;
+	std::size_t memoryUsage() const;
+
+private:
+	struct Column {
+		std::vector<std::uint32_t> codes;	// indexed by sample
+		std::vector<std::string> dictionary;
+		std::unordered_map<std::string, std::uint32_t> dictionaryCodes;
+	};
+
+	std::vector<std::string> sampleNames;
+	std::unordered_map<std::string, std::size_t> sampleIds;
+	std::vector<std::string> columnNames;
+	std::unordered_map<std::string, std::size_t> columnIds;
+	std::vector<Column> columns;
+
+};
+
+#ifndef SRC_HGC_ATTRIBUTE_TABLE_IPP_
+#define SRC_HGC_ATTRIBUTE_TABLE_IPP_
+
+inline
+HGCAttributeTable::
+HGCAttributeTable() = default;
+
+inline
+HGCAttributeTable::
+~HGCAttributeTable() = default;
+
+// adds a sample and returns its id. the values of an already contained sample are reset to missing.
+inline
+std::size_t
+HGCAttributeTable::
+addSample(const std::string& sampleName) {
+	auto [sampleId, inserted] = sampleIds.emplace(sampleName, sampleNames.size());
+	if (inserted) {
+		sampleNames.emplace_back(sampleName);
+	}
+	else {
+		for (Column& column : columns) {
+			if (sampleId->second < column.codes.size())
+				column.codes.at(sampleId->second) = missing;
+		}
+	}
+	return sampleId->second;
+}
+
+// adds a column unless it is already contained and returns its id
+inline
+std::size_t
+HGCAttributeTable::
+addColumn(const std::string& columnName) {
+	auto [columnId, inserted] = columnIds.emplace(columnName, columnNames.size());
+	if (inserted) {
+		columnNames.emplace_back(columnName);
+		columns.emplace_back();
+	}
+	return columnId->second;
+}
+
+// extends all columns to the current number of samples, which has to be done after adding samples or columns and before setting values
+inline
+void
+HGCAttributeTable::
+resizeColumns() {
+	for (Column& column : columns)
+		column.codes.resize(sampleNames.size(), missing);
+}
+
+// sets the value of a sample in a column. different columns may be set concurrently.
+inline
+void
+HGCAttributeTable::
+set(std::size_t column, std::size_t sample, const std::string& value) {
+	Column& target = columns.at(column);
+	auto [code, inserted] = target.dictionaryCodes.emplace(value, static_cast<std::uint32_t>(target.dictionary.size()));
+	if (inserted)
+		target.dictionary.emplace_back(value);
+	target.codes.at(sample) = code->second;
+}
+
+inline
+bool
+HGCAttributeTable::
+empty() const {
+	return sampleNames.empty();
+}
+
+inline
+bool
+HGCAttributeTable::
+hasSample(const std::string& sampleName) const {
+	return sampleIds.find(sampleName) != sampleIds.end();
+}
+
+// returns the id of the given sample or notFound
+inline
+std::size_t
+HGCAttributeTable::
+findSample(const std::string& sampleName) const {
+	auto sampleId = sampleIds.find(sampleName);
+	return sampleId == sampleIds.end() ? notFound : sampleId->second;
+}
+
+// returns the id of the given column or notFound
+inline
+std::size_t
+HGCAttributeTable::
+findColumn(const std::string& columnName) const {
+	auto columnId = columnIds.find(columnName);
+	return columnId == columnIds.end() ? notFound : columnId->second;
+}
+
+// returns the codes of the given samples in the given column. samples which are notFound get the code missing.
+inline
+std::vector<std::uint32_t>
+HGCAttributeTable::
+gather(std::size_t column, const std::vector<std::size_t>& samples) const {
+	const std::vector<std::uint32_t>& codes = columns.at(column).codes;
+	std::vector<std::uint32_t> gathered(samples.size(), missing);
+	for (std::size_t index = 0; index < samples.size(); index++) {
+		if (samples[index] != notFound)
+			gathered[index] = codes[samples[index]];
+	}
+	return gathered;
+}
+
+inline
+const std::vector<std::string>&
+HGCAttributeTable::
+getDictionary(std::size_t column) const {
+	return columns.at(column).dictionary;
+}
+
+// estimates the bytes held by the table: the codes, the strings and the hash map nodes, without allocator overhead
+inline
+std::size_t
+HGCAttributeTable::
+memoryUsage() const {
+	auto stringBytes = [](const std::string& string) { return sizeof(std::string) + (string.capacity() > 15 ? string.capacity() + 1 : 0); };
+	std::size_t hashNodeBytes = 2 * sizeof(void*) + sizeof(std::size_t);
+
+	std::size_t bytes = 0;
+	for (const std::string& sampleName : sampleNames)
+		bytes += 2 * stringBytes(sampleName) + hashNodeBytes + sizeof(std::size_t);
+	for (const std::string& columnName : columnNames)
+		bytes += 2 * stringBytes(columnName) + hashNodeBytes + sizeof(std::size_t);
+	for (const Column& column : columns) {
+		bytes += sizeof(Column) + column.codes.capacity() * sizeof(std::uint32_t);
+		for (const std::string& value : column.dictionary)
+			bytes += 2 * stringBytes(value) + hashNodeBytes + sizeof(std::uint32_t);
+	}
+	return bytes;
+}
+
+#endif /* SRC_HGC_ATTRIBUTE_TABLE_IPP_ */
+
+#endif /* SRC_HGC_ATTRIBUTE_TABLE_HPP_ */
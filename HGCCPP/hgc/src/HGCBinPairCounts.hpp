@@ -0,0 +1,101 @@
+#ifndef SRC_HGC_BIN_PAIR_COUNTS_HPP_
+#define SRC_HGC_BIN_PAIR_COUNTS_HPP_
+
+#include <atomic>
+#include <bitset>
+#include <cstdint>
+#include <thread>
+
+// counts for every pair of bins the number of samples in which both bins contain features. every bin stores the samples in which
+// it is occupied as a bitset, so the count of a pair is the popcount of the intersection of their bitsets, which is a bit matrix
+// product over all samples. the counts are symmetric and stored once per unordered pair.
+class HGCBinPairCounts {
+
+public:
+	HGCBinPairCounts(std::size_t numberOfBins, std::size_t numberOfSamples);
+	virtual ~HGCBinPairCounts();
+
+	void setOccupied(std::size_t bin, std::size_t sample);
+	void count(std::size_t numberOfThreads);
+	std::uint32_t get(std::size_t bin1, std::size_t bin2) const;
+
+private:
+	std::size_t pairIndex(std::size_t bin1, std::size_t bin2) const;
+
+	std::size_t numberOfBins;
+	std::size_t wordsPerBin;
+	std::vector<std::uint64_t> occupiedSamples;		// wordsPerBin words per bin
+	std::vector<std::uint32_t> counts;				// indexed by pairIndex, only for bin1 < bin2
+
+};
+
+#ifndef SRC_HGC_BIN_PAIR_COUNTS_IPP_
+#define SRC_HGC_BIN_PAIR_COUNTS_IPP_
+
+inline
+HGCBinPairCounts::
+HGCBinPairCounts(std::size_t numberOfBins, std::size_t numberOfSamples):
+	numberOfBins{numberOfBins},
+	wordsPerBin{(numberOfSamples + 63) / 64},
+	occupiedSamples(numberOfBins * ((numberOfSamples + 63) / 64), 0),
+	counts(numberOfBins < 2 ? 0 : numberOfBins * (numberOfBins - 1) / 2, 0) {
+}
+
+inline
+HGCBinPairCounts::
+~HGCBinPairCounts() = default;
+
+inline
+std::size_t
+HGCBinPairCounts::
+pairIndex(std::size_t bin1, std::size_t bin2) const {
+	if (bin1 > bin2)
+		std::swap(bin1, bin2);
+	return numberOfBins * bin1 - bin1 * (bin1 + 1) / 2 + bin2 - bin1 - 1;
+}
+
+inline
+void
+HGCBinPairCounts::
+setOccupied(std::size_t bin, std::size_t sample) {
+	occupiedSamples.at(bin * wordsPerBin + sample / 64) |= std::uint64_t{1} << (sample % 64);
+}
+
+// computes the counts of all pairs. the rows of the upper triangle are distributed over the threads.
+inline
+void
+HGCBinPairCounts::
+count(std::size_t numberOfThreads) {
+	std::atomic<std::size_t> nextBin{0};
+	auto countRows = [this, &nextBin]() {
+		for (std::size_t bin1 = nextBin++; bin1 < numberOfBins; bin1 = nextBin++) {
+			const std::uint64_t* samples1 = occupiedSamples.data() + bin1 * wordsPerBin;
+			for (std::size_t bin2 = bin1 + 1; bin2 < numberOfBins; bin2++) {
+				const std::uint64_t* samples2 = occupiedSamples.data() + bin2 * wordsPerBin;
+				std::size_t sum = 0;
+				for (std::size_t word = 0; word < wordsPerBin; word++)
+					sum += std::bitset<64>(samples1[word] & samples2[word]).count();
+				counts[pairIndex(bin1, bin2)] = static_cast<std::uint32_t>(sum);
+			}
+		}
+	};
+
+	std::vector<std::thread> threads;
+	for (std::size_t thread = 1; thread < std::min(numberOfThreads, numberOfBins); thread++)
+		threads.emplace_back(countRows);
+	countRows();
+	for (std::thread& thread : threads)
+		thread.join();
+}
+
+// returns the number of samples in which both bins are occupied. the count of a bin with itself is not stored and is 0.
+inline
+std::uint32_t
+HGCBinPairCounts::
+get(std::size_t bin1, std::size_t bin2) const {
+	return bin1 == bin2 ? 0 : counts[pairIndex(bin1, bin2)];
+}
+
+#endif /* SRC_HGC_BIN_PAIR_COUNTS_IPP_ */
+
+#endif /* SRC_HGC_BIN_PAIR_COUNTS_HPP_ */
@@ -0,0 +1,265 @@
+#ifndef SRC_HGC_BOOTSTRAP_HPP_
+#define SRC_HGC_BOOTSTRAP_HPP_
+
+#include <atomic>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <unordered_set>
+
+#include "HGCClustering.hpp"
+
+// estimates the stability of a clustering of the ged matrix by reclustering resamples of it, without computing any ged. like the
+// clustering itself, a resample links the rows of the matrix by their euclidean distances:
+// - bootstrap resamples the columns (the graphs the rows are compared over) with replacement and keeps all graphs as leaves
+// - jackknife keeps a random fraction of the graphs without replacement, both as leaves and as columns
+// the support of a merge of the reference clustering is the fraction of the resamples whose clustering contains the same cluster,
+// restricted to the leaves of the resample. the co-clustering frequency of two graphs is the fraction of the resamples containing
+// both in which they end up in the same cluster when the clustering is cut into the given number of clusters. the resamples are
+// distributed over the threads and seeded by their index, so the results don't depend on the number of threads.
+class HGCBootstrap {
+
+public:
+	struct Result {
+		std::vector<double> support;						// per merge of the reference clustering, -1 if no resample contained it non-trivially
+		std::vector<std::vector<double>> coClustering;		// per pair of graphs, -1 if no resample contained both
+	};
+
+	static Result run(const std::vector<std::vector<int>>& matrix, const std::vector<HGCClustering::Merge>& reference, const std::string& method,
+					  const std::string& mode, std::size_t numberOfResamples, double fraction, std::size_t numberOfClusters, std::uint64_t seed,
+					  std::size_t numberOfThreads);
+
+private:
+	static std::vector<double> weightedRowDistances(const std::vector<std::vector<int>>& matrix, const std::vector<std::size_t>& rows,
+													const std::vector<std::size_t>& columns, const std::vector<double>& weights);
+	static std::vector<int> cut(const std::vector<HGCClustering::Merge>& merges, std::size_t numberOfLeaves, std::size_t numberOfClusters);
+
+};
+
+#ifndef SRC_HGC_BOOTSTRAP_IPP_
+#define SRC_HGC_BOOTSTRAP_IPP_
+
+// returns the condensed euclidean distances between the given rows over the given columns, each column weighted by the number of
+// times it was drawn. the weighted columns are gathered into contiguous rows first, so the inner loop is vectorizable.
+inline
+std::vector<double>
+HGCBootstrap::
+weightedRowDistances(const std::vector<std::vector<int>>& matrix, const std::vector<std::size_t>& rows, const std::vector<std::size_t>& columns, const std::vector<double>& weights) {
+	std::size_t numberOfRows = rows.size();
+	std::size_t numberOfColumns = columns.size();
+	std::vector<double> gathered(numberOfRows * numberOfColumns);
+	for (std::size_t row = 0; row < numberOfRows; row++) {
+		const std::vector<int>& source = matrix.at(rows.at(row));
+		for (std::size_t column = 0; column < numberOfColumns; column++)
+			gathered[row * numberOfColumns + column] = static_cast<double>(source.at(columns.at(column))) * std::sqrt(weights.at(column));
+	}
+
+	std::vector<double> condensed(numberOfRows < 2 ? 0 : numberOfRows * (numberOfRows - 1) / 2);
+	std::size_t index = 0;
+	for (std::size_t row1 = 0; row1 < numberOfRows; row1++) {
+		const double* values1 = gathered.data() + row1 * numberOfColumns;
+		for (std::size_t row2 = row1 + 1; row2 < numberOfRows; row2++) {
+			const double* values2 = gathered.data() + row2 * numberOfColumns;
+			double sum = 0;
+			for (std::size_t column = 0; column < numberOfColumns; column++)
+				sum += (values1[column] - values2[column]) * (values1[column] - values2[column]);
+			condensed[index++] = std::sqrt(sum);
+		}
+	}
+	return condensed;
+}
+
+// cuts a clustering into at most the given number of clusters by applying all but its last merges, as scipy's maxclust criterion
+// does for monotonic clusterings. returns the cluster of each leaf.
+inline
+std::vector<int>
+HGCBootstrap::
+cut(const std::vector<HGCClustering::Merge>& merges, std::size_t numberOfLeaves, std::size_t numberOfClusters) {
+	std::vector<std::size_t> parents(2 * numberOfLeaves);
+	std::iota(parents.begin(), parents.end(), 0);
+	auto find = [&parents](std::size_t cluster) {
+		while (parents.at(cluster) != cluster) {
+			parents.at(cluster) = parents.at(parents.at(cluster));
+			cluster = parents.at(cluster);
+		}
+		return cluster;
+	};
+
+	std::size_t appliedMerges = numberOfLeaves - std::min(std::max(numberOfClusters, static_cast<std::size_t>(1)), numberOfLeaves);
+	for (std::size_t step = 0; step < appliedMerges; step++) {
+		parents.at(find(merges.at(step).cluster1)) = numberOfLeaves + step;
+		parents.at(find(merges.at(step).cluster2)) = numberOfLeaves + step;
+	}
+
+	std::vector<int> clusters(numberOfLeaves);
+	for (std::size_t leaf = 0; leaf < numberOfLeaves; leaf++)
+		clusters.at(leaf) = static_cast<int>(find(leaf));
+	return clusters;
+}
+
+inline
+HGCBootstrap::Result
+HGCBootstrap::
+run(const std::vector<std::vector<int>>& matrix, const std::vector<HGCClustering::Merge>& reference, const std::string& method, const std::string& mode,
+	std::size_t numberOfResamples, double fraction, std::size_t numberOfClusters, std::uint64_t seed, std::size_t numberOfThreads) {
+	if (mode != "bootstrap" && mode != "jackknife")
+		throw std::runtime_error("\"" + mode + "\" is an invalid resampling mode. Use \"bootstrap\" or \"jackknife\".");
+	if (mode == "jackknife" && (fraction <= 0 || fraction >= 1))
+		throw std::runtime_error("The jackknife fraction has to lie between 0 and 1.");
+	std::size_t numberOfGraphs = matrix.size();
+	if (reference.size() + 1 != numberOfGraphs)
+		throw std::runtime_error("The reference clustering doesn't belong to the distance matrix.");
+
+	// a cluster is identified by the sum of random keys of its leaves, so the cluster of a resample can be compared to the reference
+	// cluster restricted to the leaves of the resample without comparing leaf sets
+	std::mt19937_64 keyGenerator(seed);
+	std::vector<std::uint64_t> leafKeys(numberOfGraphs);
+	for (std::uint64_t& key : leafKeys)
+		key = keyGenerator();
+
+	std::vector<std::size_t> supportCounts(reference.size(), 0);
+	std::vector<std::size_t> applicableCounts(reference.size(), 0);
+	std::vector<std::vector<int>> resampleClusters(numberOfResamples);	// the cluster of each graph per resample, -1 if left out
+	std::mutex countsMutex;
+	std::atomic<std::size_t> nextResample{0};
+
+	auto resampleWorker = [&]() {
+		std::vector<std::size_t> localSupport(reference.size(), 0);
+		std::vector<std::size_t> localApplicable(reference.size(), 0);
+		for (std::size_t resample = nextResample++; resample < numberOfResamples; resample = nextResample++) {
+			std::mt19937_64 generator(seed + 0x9e3779b97f4a7c15ULL * (resample + 1));
+
+			// leaves and weighted columns of the resample
+			std::vector<std::size_t> leaves;
+			std::vector<std::size_t> columns;
+			std::vector<double> weights;
+			if (mode == "bootstrap") {
+				leaves.resize(numberOfGraphs);
+				std::iota(leaves.begin(), leaves.end(), 0);
+				std::vector<std::size_t> draws(numberOfGraphs, 0);
+				std::uniform_int_distribution<std::size_t> distribution(0, numberOfGraphs - 1);
+				for (std::size_t draw = 0; draw < numberOfGraphs; draw++)
+					draws.at(distribution(generator))++;
+				for (std::size_t graphId = 0; graphId < numberOfGraphs; graphId++) {
+					if (draws.at(graphId) > 0) {
+						columns.emplace_back(graphId);
+						weights.emplace_back(static_cast<double>(draws.at(graphId)));
+					}
+				}
+			}
+			else {
+				leaves.resize(numberOfGraphs);
+				std::iota(leaves.begin(), leaves.end(), 0);
+				std::shuffle(leaves.begin(), leaves.end(), generator);
+				leaves.resize(std::max(static_cast<std::size_t>(std::llround(fraction * static_cast<double>(numberOfGraphs))), static_cast<std::size_t>(2)));
+				std::sort(leaves.begin(), leaves.end());
+				columns = leaves;
+				weights.assign(leaves.size(), 1.0);
+			}
+
+			std::vector<HGCClustering::Merge> merges = HGCClustering::linkage(weightedRowDistances(matrix, leaves, columns, weights), leaves.size(), method);
+
+			// the clusters of the resample, by the keys of their leaves
+			std::vector<std::uint64_t> clusterKeys(2 * leaves.size());
+			for (std::size_t leaf = 0; leaf < leaves.size(); leaf++)
+				clusterKeys.at(leaf) = leafKeys.at(leaves.at(leaf));
+			std::unordered_set<std::uint64_t> clusters;
+			for (std::size_t step = 0; step < merges.size(); step++) {
+				clusterKeys.at(leaves.size() + step) = clusterKeys.at(merges.at(step).cluster1) + clusterKeys.at(merges.at(step).cluster2);
+				clusters.emplace(clusterKeys.at(leaves.size() + step));
+			}
+
+			// the reference clusters restricted to the leaves of the resample. a restricted cluster with a single leaf or all leaves
+			// is contained in every clustering and doesn't count.
+			std::vector<bool> isLeaf(numberOfGraphs, false);
+			for (std::size_t leaf : leaves)
+				isLeaf.at(leaf) = true;
+			std::vector<std::uint64_t> referenceKeys(2 * numberOfGraphs, 0);
+			std::vector<std::size_t> referenceSizes(2 * numberOfGraphs, 0);
+			for (std::size_t graphId = 0; graphId < numberOfGraphs; graphId++) {
+				referenceKeys.at(graphId) = isLeaf.at(graphId) ? leafKeys.at(graphId) : 0;
+				referenceSizes.at(graphId) = isLeaf.at(graphId) ? 1 : 0;
+			}
+			for (std::size_t step = 0; step < reference.size(); step++) {
+				std::size_t cluster = numberOfGraphs + step;
+				referenceKeys.at(cluster) = referenceKeys.at(reference.at(step).cluster1) + referenceKeys.at(reference.at(step).cluster2);
+				referenceSizes.at(cluster) = referenceSizes.at(reference.at(step).cluster1) + referenceSizes.at(reference.at(step).cluster2);
+				if (referenceSizes.at(cluster) < 2 || referenceSizes.at(cluster) == leaves.size())
+					continue;
+				localApplicable.at(step)++;
+				if (clusters.find(referenceKeys.at(cluster)) != clusters.end())
+					localSupport.at(step)++;
+			}
+
+			std::vector<int> leafClusters = cut(merges, leaves.size(), numberOfClusters);
+			std::vector<int>& graphClusters = resampleClusters.at(resample);
+			graphClusters.assign(numberOfGraphs, -1);
+			for (std::size_t leaf = 0; leaf < leaves.size(); leaf++)
+				graphClusters.at(leaves.at(leaf)) = leafClusters.at(leaf);
+		}
+
+		std::lock_guard<std::mutex> lock(countsMutex);
+		for (std::size_t step = 0; step < reference.size(); step++) {
+			supportCounts.at(step) += localSupport.at(step);
+			applicableCounts.at(step) += localApplicable.at(step);
+		}
+	};
+
+	numberOfThreads = std::max(std::min(numberOfThreads, numberOfResamples), static_cast<std::size_t>(1));
+	std::vector<std::thread> threads;
+	for (std::size_t thread = 1; thread < numberOfThreads; thread++)
+		threads.emplace_back(resampleWorker);
+	resampleWorker();
+	for (std::thread& thread : threads)
+		thread.join();
+
+	Result result;
+	result.support.resize(reference.size());
+	for (std::size_t step = 0; step < reference.size(); step++)
+		result.support.at(step) = applicableCounts.at(step) == 0 ? -1.0 : static_cast<double>(supportCounts.at(step)) / static_cast<double>(applicableCounts.at(step));
+
+	// the co-clustering frequencies, with the rows distributed over the threads. the clusters are transposed to one contiguous row
+	// of resamples per graph first, so a pair compares two rows.
+	std::vector<int> graphClusters(numberOfGraphs * numberOfResamples);
+	for (std::size_t resample = 0; resample < numberOfResamples; resample++) {
+		for (std::size_t graphId = 0; graphId < numberOfGraphs; graphId++)
+			graphClusters[graphId * numberOfResamples + resample] = resampleClusters.at(resample).at(graphId);
+	}
+	resampleClusters.clear();
+
+	result.coClustering.assign(numberOfGraphs, std::vector<double>(numberOfGraphs, -1.0));
+	std::atomic<std::size_t> nextRow{0};
+	auto coClusteringWorker = [&]() {
+		for (std::size_t graphId1 = nextRow++; graphId1 < numberOfGraphs; graphId1 = nextRow++) {
+			const int* clusters1 = graphClusters.data() + graphId1 * numberOfResamples;
+			for (std::size_t graphId2 = graphId1; graphId2 < numberOfGraphs; graphId2++) {
+				const int* clusters2 = graphClusters.data() + graphId2 * numberOfResamples;
+				std::size_t together = 0;
+				std::size_t present = 0;
+				for (std::size_t resample = 0; resample < numberOfResamples; resample++) {
+					bool both = clusters1[resample] >= 0 && clusters2[resample] >= 0;
+					present += both ? 1 : 0;
+					together += both && clusters1[resample] == clusters2[resample] ? 1 : 0;
+				}
+				if (present > 0)
+					result.coClustering[graphId1][graphId2] = static_cast<double>(together) / static_cast<double>(present);
+			}
+		}
+	};
+	threads.clear();
+	for (std::size_t thread = 1; thread < numberOfThreads; thread++)
+		threads.emplace_back(coClusteringWorker);
+	coClusteringWorker();
+	for (std::thread& thread : threads)
+		thread.join();
+	for (std::size_t graphId1 = 0; graphId1 < numberOfGraphs; graphId1++) {
+		for (std::size_t graphId2 = 0; graphId2 < graphId1; graphId2++)
+			result.coClustering[graphId1][graphId2] = result.coClustering[graphId2][graphId1];
+	}
+
+	return result;
+}
+
+#endif /* SRC_HGC_BOOTSTRAP_IPP_ */
+
+#endif /* SRC_HGC_BOOTSTRAP_HPP_ */
@@ -0,0 +1,134 @@
+#ifndef SRC_HGC_CHECKPOINT_HPP_
+#define SRC_HGC_CHECKPOINT_HPP_
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+
+// an append-only file of completed rows of the ged matrix. a record consists of the row index followed by the row's distances,
+// so a record which was torn by a crash is simply ignored on the next load.
+class HGCCheckpoint {
+
+public:
+	HGCCheckpoint(const std::string& path, std::size_t numberOfGraphs, std::uint64_t fingerprint);
+	virtual ~HGCCheckpoint();
+
+	std::vector<std::size_t> load(std::vector<std::vector<int>>& distanceMatrix);
+	void append(std::size_t row, const std::vector<int>& distances);
+	void flush();
+
+	static std::uint64_t hash(const void* data, std::size_t size, std::uint64_t seed = 14695981039346656037ULL);
+
+private:
+	std::string path;
+	std::uint64_t numberOfGraphs;
+	std::uint64_t fingerprint;
+	std::ofstream file;
+
+	static constexpr char magic[8] = {'H', 'G', 'C', 'C', 'K', 'P', 'T', '1'};
+
+};
+
+#ifndef SRC_HGC_CHECKPOINT_IPP_
+#define SRC_HGC_CHECKPOINT_IPP_
+
+inline
+HGCCheckpoint::
+HGCCheckpoint(const std::string& path, std::size_t numberOfGraphs, std::uint64_t fingerprint):
+	path{path},
+	numberOfGraphs{numberOfGraphs},
+	fingerprint{fingerprint} {
+}
+
+inline
+HGCCheckpoint::
+~HGCCheckpoint() = default;
+
+// restores all complete rows of a matching checkpoint file into the distance matrix and returns their indices.
+// a missing or non-matching file is replaced by an empty checkpoint, with a warning if it belongs to another computation.
+inline
+std::vector<std::size_t>
+HGCCheckpoint::
+load(std::vector<std::vector<int>>& distanceMatrix) {
+	std::vector<std::size_t> restoredRows;
+
+	std::ifstream input(path, std::ios::binary);
+	bool existing = input && input.peek() != std::ifstream::traits_type::eof();
+	char fileMagic[sizeof(magic)] = {};
+	std::uint64_t fileNumberOfGraphs = 0;
+	std::uint64_t fileFingerprint = 0;
+	input.read(fileMagic, sizeof(fileMagic));
+	input.read(reinterpret_cast<char*>(&fileNumberOfGraphs), sizeof(fileNumberOfGraphs));
+	input.read(reinterpret_cast<char*>(&fileFingerprint), sizeof(fileFingerprint));
+	bool matching = input && std::equal(magic, magic + sizeof(magic), fileMagic) && fileNumberOfGraphs == numberOfGraphs && fileFingerprint == fingerprint;
+	if (!matching && existing)
+		std::cout << "Warning! The checkpoint file \"" + path + "\" belongs to another computation and is replaced." << std::endl;
+
+	if (matching) {
+		std::uint64_t row;
+		std::vector<int> distances(numberOfGraphs);
+		while (input.read(reinterpret_cast<char*>(&row), sizeof(row)) && input.read(reinterpret_cast<char*>(distances.data()), static_cast<std::streamsize>(distances.size() * sizeof(int)))) {
+			if (row >= numberOfGraphs)
+				break;
+			distanceMatrix.at(row) = distances;
+			restoredRows.emplace_back(row);
+		}
+	}
+	input.close();
+
+	// rewrite the file, which also drops a torn record at its end. the rewrite goes into a temporary file which then replaces the
+	// checkpoint, so a crash during the rewrite keeps the restored rows.
+	std::string temporaryPath = path + ".tmp";
+	file.open(temporaryPath, std::ios::binary | std::ios::trunc);
+	if (!file)
+		throw std::runtime_error("Error! Couldn't open checkpoint file \"" + temporaryPath + "\".");
+	file.write(magic, sizeof(magic));
+	file.write(reinterpret_cast<const char*>(&numberOfGraphs), sizeof(numberOfGraphs));
+	file.write(reinterpret_cast<const char*>(&fingerprint), sizeof(fingerprint));
+	for (std::size_t row : restoredRows)
+		append(row, distanceMatrix.at(row));
+	file.close();
+	if (!file || std::rename(temporaryPath.c_str(), path.c_str()) != 0)
+		throw std::runtime_error("Error! Couldn't replace checkpoint file \"" + path + "\".");
+
+	file.open(path, std::ios::binary | std::ios::app);
+	if (!file)
+		throw std::runtime_error("Error! Couldn't open checkpoint file \"" + path + "\".");
+	return restoredRows;
+}
+
+// appends a completed row. it is only guaranteed to be on disk after the next flush.
+inline
+void
+HGCCheckpoint::
+append(std::size_t row, const std::vector<int>& distances) {
+	std::uint64_t fileRow = row;
+	file.write(reinterpret_cast<const char*>(&fileRow), sizeof(fileRow));
+	file.write(reinterpret_cast<const char*>(distances.data()), static_cast<std::streamsize>(distances.size() * sizeof(int)));
+}
+
+inline
+void
+HGCCheckpoint::
+flush() {
+	file.flush();
+}
+
+// hashes the given bytes using fnv-1a, which is used to detect checkpoints of a different environment
+inline
+std::uint64_t
+HGCCheckpoint::
+hash(const void* data, std::size_t size, std::uint64_t seed) {
+	const auto* bytes = static_cast<const unsigned char*>(data);
+	std::uint64_t result = seed;
+	for (std::size_t index = 0; index < size; index++) {
+		result ^= bytes[index];
+		result *= 1099511628211ULL;
+	}
+	return result;
+}
+
+#endif /* SRC_HGC_CHECKPOINT_IPP_ */
+
+#endif /* SRC_HGC_CHECKPOINT_HPP_ */
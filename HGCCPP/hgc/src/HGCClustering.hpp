@@ -0,0 +1,268 @@
+#ifndef SRC_HGC_CLUSTERING_HPP_
+#define SRC_HGC_CLUSTERING_HPP_
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+#include <tuple>
+
+// hierarchical agglomerative clustering of the GED matrix, natively and equivalent to what the python interface does with scipy:
+// the rows of the matrix are compared by their euclidean distance (pdist) and then linked by one of scipy's linkage methods. the
+// merges are returned in scipy's linkage format, so the results of both interfaces can be used interchangeably.
+class HGCClustering {
+
+public:
+	// a row of the linkage matrix. clusters 0..n-1 are the observations, the cluster created by the i-th merge has the id n+i.
+	struct Merge {
+		std::size_t cluster1;
+		std::size_t cluster2;
+		double distance;
+		std::size_t size;
+	};
+
+	static std::string parseAlgorithm(const std::string& algorithm);
+	static std::vector<double> rowDistances(const std::vector<std::vector<int>>& matrix, std::size_t numberOfThreads);
+	static void condensedRowDistances(const std::int32_t* condensed, std::size_t numberOfRows, double* output, std::size_t numberOfThreads);
+	static std::vector<Merge> linkage(std::vector<double> condensed, std::size_t numberOfObservations, const std::string& method);
+	static std::vector<Merge> linkageFromSpanningTree(std::vector<std::tuple<std::size_t, std::size_t, double>> edges, std::size_t numberOfObservations);
+	static std::size_t condensedIndex(std::size_t numberOfObservations, std::size_t i, std::size_t j);
+
+private:
+	static double lanceWilliams(const std::string& method, double distanceXI, double distanceYI, double distanceXY, double sizeX, double sizeY, double sizeI);
+
+};
+
+#ifndef SRC_HGC_CLUSTERING_IPP_
+#define SRC_HGC_CLUSTERING_IPP_
+
+// maps the algorithm names accepted by main.py onto scipy's linkage method names. an empty name defaults to upgma.
+inline
+std::string
+HGCClustering::
+parseAlgorithm(const std::string& algorithm) {
+	if (algorithm.empty() || algorithm == "upgma" || algorithm == "average")
+		return "average";
+	if (algorithm == "nearest point" || algorithm == "nearest_point" || algorithm == "single")
+		return "single";
+	if (algorithm == "farthest point" || algorithm == "farthest_point" || algorithm == "complete")
+		return "complete";
+	if (algorithm == "wpgma" || algorithm == "weighted")
+		return "weighted";
+	if (algorithm == "upgmc" || algorithm == "centroid")
+		return "centroid";
+	if (algorithm == "wpgmc" || algorithm == "median")
+		return "median";
+	if (algorithm == "incremental" || algorithm == "ward")
+		return "ward";
+	throw std::runtime_error("Error! Couldn't generate clustering: \"" + algorithm + "\" is an invalid clustering algorithm.");
+}
+
+inline
+std::size_t
+HGCClustering::
+condensedIndex(std::size_t numberOfObservations, std::size_t i, std::size_t j) {
+	if (i > j)
+		std::swap(i, j);
+	return numberOfObservations * i - i * (i + 1) / 2 + j - i - 1;
+}
+
+// returns the condensed matrix of the euclidean distances between the rows of the given matrix. the rows are distributed over the threads.
+inline
+std::vector<double>
+HGCClustering::
+rowDistances(const std::vector<std::vector<int>>& matrix, std::size_t numberOfThreads) {
+	std::size_t numberOfRows = matrix.size();
+	std::vector<double> condensed(numberOfRows < 2 ? 0 : numberOfRows * (numberOfRows - 1) / 2);
+
+	auto computeRows = [&matrix, &condensed, numberOfRows, numberOfThreads](std::size_t firstRow) {
+		for (std::size_t i = firstRow; i < numberOfRows; i += numberOfThreads) {
+			const std::vector<int>& row1 = matrix.at(i);
+			for (std::size_t j = i + 1; j < numberOfRows; j++) {
+				const std::vector<int>& row2 = matrix.at(j);
+				double sum = 0;
+				for (std::size_t column = 0; column < row1.size(); column++) {
+					double difference = static_cast<double>(row1[column]) - static_cast<double>(row2[column]);
+					sum += difference * difference;
+				}
+				condensed[condensedIndex(numberOfRows, i, j)] = std::sqrt(sum);
+			}
+		}
+	};
+
+	numberOfThreads = std::max(std::min(numberOfThreads, numberOfRows), static_cast<std::size_t>(1));
+	std::vector<std::thread> threads;
+	for (std::size_t thread = 1; thread < numberOfThreads; thread++)
+		threads.emplace_back(computeRows, thread);
+	computeRows(0);
+	for (std::thread& thread : threads)
+		thread.join();
+
+	return condensed;
+}
+
+// writes the condensed matrix of the euclidean distances between the rows of the symmetric matrix, whose upper triangle is given as
+// a condensed matrix (e.g. a mapped distance matrix), into the output. the same as rowDistances without unpacking the matrix.
+inline
+void
+HGCClustering::
+condensedRowDistances(const std::int32_t* condensed, std::size_t numberOfRows, double* output, std::size_t numberOfThreads) {
+	auto value = [condensed, numberOfRows](std::size_t i, std::size_t j) {
+		return i == j ? 0.0 : static_cast<double>(condensed[condensedIndex(numberOfRows, i, j)]);
+	};
+	auto computeRows = [&value, output, numberOfRows, numberOfThreads](std::size_t firstRow) {
+		std::vector<double> row1(numberOfRows);
+		for (std::size_t i = firstRow; i < numberOfRows; i += numberOfThreads) {
+			for (std::size_t column = 0; column < numberOfRows; column++)
+				row1[column] = value(i, column);
+			for (std::size_t j = i + 1; j < numberOfRows; j++) {
+				double sum = 0;
+				for (std::size_t column = 0; column < numberOfRows; column++) {
+					double difference = row1[column] - value(j, column);
+					sum += difference * difference;
+				}
+				output[condensedIndex(numberOfRows, i, j)] = std::sqrt(sum);
+			}
+		}
+	};
+
+	numberOfThreads = std::max(std::min(numberOfThreads, numberOfRows), static_cast<std::size_t>(1));
+	std::vector<std::thread> threads;
+	for (std::size_t thread = 1; thread < numberOfThreads; thread++)
+		threads.emplace_back(computeRows, thread);
+	computeRows(0);
+	for (std::thread& thread : threads)
+		thread.join();
+}
+
+// the distance between cluster i and the union of the clusters x and y, using the same update formulas as scipy
+inline
+double
+HGCClustering::
+lanceWilliams(const std::string& method, double distanceXI, double distanceYI, double distanceXY, double sizeX, double sizeY, double sizeI) {
+	if (method == "single")
+		return std::min(distanceXI, distanceYI);
+	if (method == "complete")
+		return std::max(distanceXI, distanceYI);
+	if (method == "average")
+		return (sizeX * distanceXI + sizeY * distanceYI) / (sizeX + sizeY);
+	if (method == "weighted")
+		return 0.5 * (distanceXI + distanceYI);
+	if (method == "centroid")
+		return std::sqrt(std::max(((sizeX * distanceXI * distanceXI) + (sizeY * distanceYI * distanceYI) - (sizeX * sizeY * distanceXY * distanceXY) / (sizeX + sizeY)) / (sizeX + sizeY), 0.0));
+	if (method == "median")
+		return std::sqrt(std::max(0.5 * (distanceXI * distanceXI + distanceYI * distanceYI) - 0.25 * distanceXY * distanceXY, 0.0));
+	double t = 1.0 / (sizeX + sizeY + sizeI);	// ward
+	return std::sqrt(std::max((sizeI + sizeX) * t * distanceXI * distanceXI + (sizeI + sizeY) * t * distanceYI * distanceYI - sizeI * t * distanceXY * distanceXY, 0.0));
+}
+
+// links the observations of a condensed distance matrix bottom-up. every cluster caches its nearest neighbor, which only has to be
+// searched again if the neighbor was merged away, so most merges cost linear instead of quadratic time. this also handles centroid
+// and median, whose merge distances are not monotonic.
+inline
+std::vector<HGCClustering::Merge>
+HGCClustering::
+linkage(std::vector<double> condensed, std::size_t numberOfObservations, const std::string& method) {
+	parseAlgorithm(method);
+	std::vector<Merge> merges;
+	if (numberOfObservations < 2)
+		return merges;
+	merges.reserve(numberOfObservations - 1);
+
+	std::vector<bool> active(numberOfObservations, true);
+	std::vector<std::size_t> sizes(numberOfObservations, 1);
+	std::vector<std::size_t> clusterIds(numberOfObservations);
+	std::vector<std::size_t> nearest(numberOfObservations);
+	std::vector<double> nearestDistances(numberOfObservations);
+	for (std::size_t i = 0; i < numberOfObservations; i++)
+		clusterIds.at(i) = i;
+
+	auto findNearest = [&](std::size_t i) {
+		nearestDistances.at(i) = std::numeric_limits<double>::infinity();
+		for (std::size_t j = 0; j < numberOfObservations; j++) {
+			if (j != i && active.at(j) && condensed[condensedIndex(numberOfObservations, i, j)] < nearestDistances.at(i)) {
+				nearestDistances.at(i) = condensed[condensedIndex(numberOfObservations, i, j)];
+				nearest.at(i) = j;
+			}
+		}
+	};
+	for (std::size_t i = 0; i < numberOfObservations; i++)
+		findNearest(i);
+
+	for (std::size_t step = 0; step + 1 < numberOfObservations; step++) {
+
+		// the closest pair is the cluster with the smallest distance to its nearest neighbor
+		std::size_t x = numberOfObservations;
+		for (std::size_t i = 0; i < numberOfObservations; i++) {
+			if (active.at(i) && (x == numberOfObservations || nearestDistances.at(i) < nearestDistances.at(x)))
+				x = i;
+		}
+		std::size_t y = nearest.at(x);
+		double distanceXY = nearestDistances.at(x);
+		merges.push_back({std::min(clusterIds.at(x), clusterIds.at(y)), std::max(clusterIds.at(x), clusterIds.at(y)), distanceXY, sizes.at(x) + sizes.at(y)});
+
+		// the union takes the place of y
+		for (std::size_t i = 0; i < numberOfObservations; i++) {
+			if (!active.at(i) || i == x || i == y)
+				continue;
+			double& distanceYI = condensed[condensedIndex(numberOfObservations, y, i)];
+			distanceYI = lanceWilliams(method, condensed[condensedIndex(numberOfObservations, x, i)], distanceYI, distanceXY,
+									   static_cast<double>(sizes.at(x)), static_cast<double>(sizes.at(y)), static_cast<double>(sizes.at(i)));
+		}
+		active.at(x) = false;
+		sizes.at(y) += sizes.at(x);
+		clusterIds.at(y) = numberOfObservations + step;
+
+		for (std::size_t i = 0; i < numberOfObservations; i++) {
+			if (!active.at(i) || i == y)
+				continue;
+			if (nearest.at(i) == x || nearest.at(i) == y)
+				findNearest(i);
+			else if (condensed[condensedIndex(numberOfObservations, y, i)] < nearestDistances.at(i)) {
+				nearestDistances.at(i) = condensed[condensedIndex(numberOfObservations, y, i)];
+				nearest.at(i) = y;
+			}
+		}
+		findNearest(y);
+	}
+
+	return merges;
+}
+
+// converts a minimum spanning tree into the single linkage merges: the edges are merged in ascending order of their weight, and a
+// union-find structure tracks the cluster which each observation currently belongs to
+inline
+std::vector<HGCClustering::Merge>
+HGCClustering::
+linkageFromSpanningTree(std::vector<std::tuple<std::size_t, std::size_t, double>> edges, std::size_t numberOfObservations) {
+	std::stable_sort(edges.begin(), edges.end(), [](const auto& a, const auto& b) { return std::get<2>(a) < std::get<2>(b); });
+
+	std::vector<std::size_t> parents(2 * numberOfObservations);
+	std::iota(parents.begin(), parents.end(), 0);
+	std::vector<std::size_t> sizes(2 * numberOfObservations, 1);
+	auto find = [&parents](std::size_t cluster) {
+		while (parents.at(cluster) != cluster) {
+			parents.at(cluster) = parents.at(parents.at(cluster));
+			cluster = parents.at(cluster);
+		}
+		return cluster;
+	};
+
+	std::vector<Merge> merges;
+	for (const auto& [observation1, observation2, distance] : edges) {
+		std::size_t cluster1 = find(observation1);
+		std::size_t cluster2 = find(observation2);
+		std::size_t merged = numberOfObservations + merges.size();
+		parents.at(cluster1) = merged;
+		parents.at(cluster2) = merged;
+		sizes.at(merged) = sizes.at(cluster1) + sizes.at(cluster2);
+		merges.push_back({std::min(cluster1, cluster2), std::max(cluster1, cluster2), distance, sizes.at(merged)});
+	}
+	return merges;
+}
+
+#endif /* SRC_HGC_CLUSTERING_IPP_ */
+
+#endif /* SRC_HGC_CLUSTERING_HPP_ */
@@ -0,0 +1,358 @@
+#ifndef SRC_HGC_COST_DISPATCHER_HPP_
+#define SRC_HGC_COST_DISPATCHER_HPP_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <thread>
+
+#include <pybind11/embed.h>
+
+// evaluates the python edit cost functions for many solver threads without letting them contend for the GIL. the solver threads
+// first look the cost up in a memoization table, which they read without locks. on a miss they post the query into a lock-free
+// queue and wait. a single dispatch thread drains the queue in batches, evaluates each batch while holding the GIL once and
+// publishes the results into the table. the cost functions therefore have to be pure. the dispatcher must only run while the
+// threads which start and stop it don't hold the GIL.
+template<class UserNodeLabel, class UserEdgeLabel>
+class HGCCostDispatcher {
+
+public:
+	enum Function : std::uint8_t {
+		NODE_INS, NODE_DEL, NODE_REL, EDGE_INS, EDGE_DEL, EDGE_REL
+	};
+
+	HGCCostDispatcher(const pybind11::module& pythonModule, std::size_t memoCapacity);
+	virtual ~HGCCostDispatcher();
+
+	double nodeCost(Function function, const UserNodeLabel& label1, const UserNodeLabel& label2);
+	double edgeCost(Function function, const UserEdgeLabel& label1, const UserEdgeLabel& label2);
+
+	std::size_t getNumberOfPythonCalls() const;
+
+private:
+	// the functions of one label type are memoized in one table with a fixed capacity. only the dispatch thread inserts, and a slot
+	// is published by its ready flag after its key and value are written, so readers never see a partially written slot.
+	template<class Label>
+	class MemoTable {
+
+	public:
+		explicit MemoTable(std::size_t capacity);
+
+		bool find(Function function, const Label& label1, const Label& label2, double& value) const;
+		void insert(Function function, const Label& label1, const Label& label2, double value);
+
+	private:
+		struct Slot {
+			std::atomic<bool> ready{false};
+			Function function;
+			Label label1;
+			Label label2;
+			double value;
+		};
+
+		std::size_t hash(Function function, const Label& label1, const Label& label2) const;
+
+		std::unique_ptr<Slot[]> slots;
+		std::size_t mask;
+		std::size_t size;		// only accessed by the dispatch thread
+		std::size_t maximumSize;
+
+	};
+
+	// a cost query, owned by the waiting solver thread
+	struct Request {
+		std::atomic<Request*> next;
+		Function function;
+		UserNodeLabel nodeLabels[2];
+		UserEdgeLabel edgeLabels[2];
+		double result;
+		std::string error;
+		std::atomic<bool> done;
+	};
+
+	void post(Request& request);
+	Request* pop();
+	void dispatch();
+	double evaluate(const Request& request);
+	double await(Request& request);
+
+	static constexpr const char* functionNames[] = {
+		"node_ins_cost_fun", "node_del_cost_fun", "node_rel_cost_fun", "edge_ins_cost_fun", "edge_del_cost_fun", "edge_rel_cost_fun"
+	};
+
+	const pybind11::module& pythonModule;		// owned by the edit costs, referenced so that no reference count is touched without the GIL
+	MemoTable<UserNodeLabel> nodeMemo;
+	MemoTable<UserEdgeLabel> edgeMemo;
+
+	// intrusive multi-producer single-consumer queue with a stub node: producers only exchange the head, the dispatch thread owns the tail
+	std::atomic<Request*> head;
+	Request* tail;
+	Request stub;
+
+	std::atomic<bool> stopRequested;
+	std::atomic<std::size_t> pythonCalls;
+	std::thread dispatchThread;
+
+};
+
+#ifndef SRC_HGC_COST_DISPATCHER_IPP_
+#define SRC_HGC_COST_DISPATCHER_IPP_
+
+template<class UserNodeLabel, class UserEdgeLabel>
+template<class Label>
+HGCCostDispatcher<UserNodeLabel, UserEdgeLabel>::MemoTable<Label>::
+MemoTable(std::size_t capacity):
+	size{0} {
+	std::size_t slotCount = 16;
+	while (slotCount < capacity)
+		slotCount <<= 1;
+	slots = std::make_unique<Slot[]>(slotCount);
+	mask = slotCount - 1;
+	maximumSize = slotCount / 4 * 3;
+}
+
+template<class UserNodeLabel, class UserEdgeLabel>
+template<class Label>
+std::size_t
+HGCCostDispatcher<UserNodeLabel, UserEdgeLabel>::MemoTable<Label>::
+hash(Function function, const Label& label1, const Label& label2) const {
+	std::size_t seed = std::hash<Label>()(label1);
+	seed ^= std::hash<Label>()(label2) + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2);
+	seed ^= static_cast<std::size_t>(function) + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2);
+	return seed;
+}
+
+// linear probing up to the first unpublished slot. a slot which is being written is treated as a miss.
+template<class UserNodeLabel, class UserEdgeLabel>
+template<class Label>
+bool
+HGCCostDispatcher<UserNodeLabel, UserEdgeLabel>::MemoTable<Label>::
+find(Function function, const Label& label1, const Label& label2, double& value) const {
+	for (std::size_t index = hash(function, label1, label2) & mask; ; index = (index + 1) & mask) {
+		const Slot& slot = slots[index];
+		if (!slot.ready.load(std::memory_order_acquire))
+			return false;
+		if (slot.function == function && slot.label1 == label1 && slot.label2 == label2) {
+			value = slot.value;
+			return true;
+		}
+	}
+}
+
+// inserts a value unless the table is full, in which case the value is simply not memoized
+template<class UserNodeLabel, class UserEdgeLabel>
+template<class Label>
+void
+HGCCostDispatcher<UserNodeLabel, UserEdgeLabel>::MemoTable<Label>::
+insert(Function function, const Label& label1, const Label& label2, double value) {
+	if (size >= maximumSize)
+		return;
+
+	std::size_t index = hash(function, label1, label2) & mask;
+	while (slots[index].ready.load(std::memory_order_relaxed)) {
+		if (slots[index].function == function && slots[index].label1 == label1 && slots[index].label2 == label2)
+			return;
+		index = (index + 1) & mask;
+	}
+	Slot& slot = slots[index];
+	slot.function = function;
+	slot.label1 = label1;
+	slot.label2 = label2;
+	slot.value = value;
+	slot.ready.store(true, std::memory_order_release);
+	size++;
+}
+
+template<class UserNodeLabel, class UserEdgeLabel>
+HGCCostDispatcher<UserNodeLabel, UserEdgeLabel>::
+HGCCostDispatcher(const pybind11::module& pythonModule, std::size_t memoCapacity):
+	pythonModule{pythonModule},
+	nodeMemo{memoCapacity},
+	edgeMemo{memoCapacity},
+	head{&stub},
+	tail{&stub},
+	stopRequested{false},
+	pythonCalls{0} {
+	stub.next.store(nullptr, std::memory_order_relaxed);
+	dispatchThread = std::thread([this]() { dispatch(); });
+}
+
+// stops the dispatch thread after it has answered all posted requests
+template<class UserNodeLabel, class UserEdgeLabel>
+HGCCostDispatcher<UserNodeLabel, UserEdgeLabel>::
+~HGCCostDispatcher() {
+	stopRequested = true;
+	if (dispatchThread.joinable())
+		dispatchThread.join();
+}
+
+template<class UserNodeLabel, class UserEdgeLabel>
+double
+HGCCostDispatcher<UserNodeLabel, UserEdgeLabel>::
+nodeCost(Function function, const UserNodeLabel& label1, const UserNodeLabel& label2) {
+	double value;
+	if (nodeMemo.find(function, label1, label2, value))
+		return value;
+
+	Request request;
+	request.function = function;
+	request.nodeLabels[0] = label1;
+	request.nodeLabels[1] = label2;
+	return await(request);
+}
+
+template<class UserNodeLabel, class UserEdgeLabel>
+double
+HGCCostDispatcher<UserNodeLabel, UserEdgeLabel>::
+edgeCost(Function function, const UserEdgeLabel& label1, const UserEdgeLabel& label2) {
+	double value;
+	if (edgeMemo.find(function, label1, label2, value))
+		return value;
+
+	Request request;
+	request.function = function;
+	request.edgeLabels[0] = label1;
+	request.edgeLabels[1] = label2;
+	return await(request);
+}
+
+template<class UserNodeLabel, class UserEdgeLabel>
+std::size_t
+HGCCostDispatcher<UserNodeLabel, UserEdgeLabel>::
+getNumberOfPythonCalls() const {
+	return pythonCalls;
+}
+
+// posts a request and waits until the dispatch thread has answered it. errors raised by python are rethrown in the solver thread.
+template<class UserNodeLabel, class UserEdgeLabel>
+double
+HGCCostDispatcher<UserNodeLabel, UserEdgeLabel>::
+await(Request& request) {
+	request.done.store(false, std::memory_order_relaxed);
+	post(request);
+	for (std::size_t spins = 0; !request.done.load(std::memory_order_acquire); spins++) {
+		if (spins > 64)
+			std::this_thread::yield();
+	}
+	if (!request.error.empty())
+		throw std::runtime_error(request.error);
+	return request.result;
+}
+
+template<class UserNodeLabel, class UserEdgeLabel>
+void
+HGCCostDispatcher<UserNodeLabel, UserEdgeLabel>::
+post(Request& request) {
+	request.next.store(nullptr, std::memory_order_relaxed);
+	Request* previous = head.exchange(&request, std::memory_order_acq_rel);
+	previous->next.store(&request, std::memory_order_release);
+}
+
+// returns the oldest request or nullptr if the queue is empty or a producer is in the middle of posting. a request is only returned
+// once its successor is linked, so its owner is never woken up while a producer may still write into it.
+template<class UserNodeLabel, class UserEdgeLabel>
+typename HGCCostDispatcher<UserNodeLabel, UserEdgeLabel>::Request*
+HGCCostDispatcher<UserNodeLabel, UserEdgeLabel>::
+pop() {
+	Request* oldest = tail;
+	Request* next = oldest->next.load(std::memory_order_acquire);
+	if (oldest == &stub) {
+		if (!next)
+			return nullptr;
+		tail = next;
+		oldest = next;
+		next = next->next.load(std::memory_order_acquire);
+	}
+	if (next) {
+		tail = next;
+		return oldest;
+	}
+	if (oldest != head.load(std::memory_order_acquire))
+		return nullptr;
+	post(stub);
+	next = oldest->next.load(std::memory_order_acquire);
+	if (next) {
+		tail = next;
+		return oldest;
+	}
+	return nullptr;
+}
+
+// the loop of the dispatch thread. the GIL is acquired once per batch rather than once per call.
+template<class UserNodeLabel, class UserEdgeLabel>
+void
+HGCCostDispatcher<UserNodeLabel, UserEdgeLabel>::
+dispatch() {
+	std::vector<Request*> batch;
+	std::size_t idleRounds = 0;
+	while (true) {
+		for (Request* request = pop(); request; request = pop())
+			batch.push_back(request);
+
+		if (batch.empty()) {
+			if (stopRequested && head.load(std::memory_order_acquire) == tail)
+				break;
+			if (++idleRounds > 256)
+				std::this_thread::sleep_for(std::chrono::microseconds(50));
+			else
+				std::this_thread::yield();
+			continue;
+		}
+		idleRounds = 0;
+
+		{
+			pybind11::gil_scoped_acquire acquire;
+			for (Request* request : batch) {
+				try {
+					request->result = evaluate(*request);
+				}
+				catch (const std::exception& exception) {
+					request->error = std::string("Custom edit cost function \"") + functionNames[request->function] + "\" failed: " + exception.what();
+				}
+			}
+		}
+
+		for (Request* request : batch)
+			request->done.store(true, std::memory_order_release);
+		batch.clear();
+	}
+}
+
+// evaluates a request, unless an earlier request of the same batch already did, and memoizes the result. requires the GIL.
+template<class UserNodeLabel, class UserEdgeLabel>
+double
+HGCCostDispatcher<UserNodeLabel, UserEdgeLabel>::
+evaluate(const Request& request) {
+	double value;
+	const char* name = functionNames[request.function];
+	switch (request.function) {
+	case NODE_INS:
+	case NODE_DEL:
+	case NODE_REL:
+		if (nodeMemo.find(request.function, request.nodeLabels[0], request.nodeLabels[1], value))
+			return value;
+		if (request.function == NODE_REL)
+			value = pythonModule.attr(name)(request.nodeLabels[0], request.nodeLabels[1]).template cast<double>();
+		else
+			value = pythonModule.attr(name)(request.nodeLabels[0]).template cast<double>();
+		nodeMemo.insert(request.function, request.nodeLabels[0], request.nodeLabels[1], value);
+		break;
+	default:
+		if (edgeMemo.find(request.function, request.edgeLabels[0], request.edgeLabels[1], value))
+			return value;
+		if (request.function == EDGE_REL)
+			value = pythonModule.attr(name)(request.edgeLabels[0], request.edgeLabels[1]).template cast<double>();
+		else
+			value = pythonModule.attr(name)(request.edgeLabels[0]).template cast<double>();
+		edgeMemo.insert(request.function, request.edgeLabels[0], request.edgeLabels[1], value);
+		break;
+	}
+	pythonCalls.fetch_add(1, std::memory_order_relaxed);
+	return value;
+}
+
+#endif /* SRC_HGC_COST_DISPATCHER_IPP_ */
+
+#endif /* SRC_HGC_COST_DISPATCHER_HPP_ */
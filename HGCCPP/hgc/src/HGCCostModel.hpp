@@ -0,0 +1,185 @@
+#ifndef SRC_HGC_COST_MODEL_HPP_
+#define SRC_HGC_COST_MODEL_HPP_
+
+#include <array>
+#include <fstream>
+
+// estimates the runtime of solving a pair of graphs. the branch methods solve an lsape problem of size (n+m)x(n+m), whose cost grows
+// cubically, plus one small edge lsape problem per node pair, whose size is the sum of the degrees of the two nodes. the runtime is
+// modeled as c0 + c1 * (n+m)^3 + c2 * sum over all node pairs of (deg(u) + deg(v))^2, with coefficients per method that are calibrated
+// by least squares from measured runtimes.
+class HGCCostModel {
+
+public:
+	struct GraphFeatures {
+		double numberOfNodes;
+		double numberOfEdges;
+		double sumOfDegrees;
+		double sumOfSquaredDegrees;
+	};
+
+	struct Sample {
+		std::size_t graphId1;
+		std::size_t graphId2;
+		std::array<double, 3> terms;
+		double predictedSeconds;
+		double actualSeconds;
+	};
+
+	HGCCostModel();
+	virtual ~HGCCostModel();
+
+	static GraphFeatures graphFeatures(const std::vector<std::size_t>& degrees, std::size_t numberOfEdges);
+	static std::array<double, 3> terms(const GraphFeatures& graph1, const GraphFeatures& graph2);
+
+	double predict(const std::string& methodName, const GraphFeatures& graph1, const GraphFeatures& graph2) const;
+	void calibrate(const std::string& methodName, const std::vector<Sample>& samples);
+	static void writeLog(const std::string& path, const std::vector<Sample>& samples);
+
+private:
+	std::map<std::string, std::array<double, 3>> coefficients;
+
+};
+
+#ifndef SRC_HGC_COST_MODEL_IPP_
+#define SRC_HGC_COST_MODEL_IPP_
+
+// the defaults only have to order the pairs sensibly before the first calibration, so they merely reflect the relative weight of the terms
+inline
+HGCCostModel::
+HGCCostModel():
+	coefficients{
+			{"BRANCH_FAST", {1e-5, 2e-9, 0}},
+			{"BRANCH", {1e-5, 2e-9, 1e-8}},
+			{"BRANCH_TIGHT", {1e-5, 2e-9, 5e-8}}
+	} {
+}
+
+inline
+HGCCostModel::
+~HGCCostModel() = default;
+
+inline
+HGCCostModel::GraphFeatures
+HGCCostModel::
+graphFeatures(const std::vector<std::size_t>& degrees, std::size_t numberOfEdges) {
+	GraphFeatures features{static_cast<double>(degrees.size()), static_cast<double>(numberOfEdges), 0, 0};
+	for (std::size_t degree : degrees) {
+		features.sumOfDegrees += static_cast<double>(degree);
+		features.sumOfSquaredDegrees += static_cast<double>(degree * degree);
+	}
+	return features;
+}
+
+// returns the terms the runtime is modeled with. the sum over all node pairs expands to n_h * sum(d_u^2) + n_g * sum(d_v^2) + 2 * sum(d_u) * sum(d_v).
+inline
+std::array<double, 3>
+HGCCostModel::
+terms(const GraphFeatures& graph1, const GraphFeatures& graph2) {
+	double size = graph1.numberOfNodes + graph2.numberOfNodes;
+	double edgeTerm = graph2.numberOfNodes * graph1.sumOfSquaredDegrees + graph1.numberOfNodes * graph2.sumOfSquaredDegrees + 2 * graph1.sumOfDegrees * graph2.sumOfDegrees;
+	return {1, size * size * size, edgeTerm};
+}
+
+// returns the predicted runtime of a pair in seconds
+inline
+double
+HGCCostModel::
+predict(const std::string& methodName, const GraphFeatures& graph1, const GraphFeatures& graph2) const {
+	auto methodCoefficients = coefficients.find(methodName);
+	const std::array<double, 3>& values = methodCoefficients == coefficients.end() ? coefficients.at("BRANCH") : methodCoefficients->second;
+	std::array<double, 3> pairTerms = terms(graph1, graph2);
+	return values.at(0) * pairTerms.at(0) + values.at(1) * pairTerms.at(1) + values.at(2) * pairTerms.at(2);
+}
+
+// fits the coefficients of the given method to the measured runtimes using least squares. negative coefficients are dropped.
+inline
+void
+HGCCostModel::
+calibrate(const std::string& methodName, const std::vector<Sample>& samples) {
+	if (samples.size() < 3)
+		return;
+
+	// the terms differ by orders of magnitude, so they are scaled to a unit mean before solving the normal equations
+	std::array<double, 3> scales = {0, 0, 0};
+	for (const Sample& sample : samples) {
+		for (std::size_t term = 0; term < 3; term++)
+			scales.at(term) += sample.terms.at(term) / static_cast<double>(samples.size());
+	}
+
+	std::array<bool, 3> active = {true, true, true};
+	std::array<double, 3> solution = {0, 0, 0};
+	for (std::size_t attempt = 0; attempt < 3; attempt++) {
+		double normal[3][4] = {};
+		for (const Sample& sample : samples) {
+			for (std::size_t row = 0; row < 3; row++) {
+				double rowTerm = active.at(row) && scales.at(row) > 0 ? sample.terms.at(row) / scales.at(row) : 0;
+				for (std::size_t column = 0; column < 3; column++) {
+					double columnTerm = active.at(column) && scales.at(column) > 0 ? sample.terms.at(column) / scales.at(column) : 0;
+					normal[row][column] += rowTerm * columnTerm;
+				}
+				normal[row][3] += rowTerm * sample.actualSeconds;
+			}
+		}
+		for (std::size_t row = 0; row < 3; row++) {
+			if (normal[row][row] == 0) {	// inactive or constant zero terms
+				normal[row][row] = 1;
+				normal[row][3] = 0;
+			}
+		}
+
+		// gaussian elimination with partial pivoting
+		for (std::size_t pivot = 0; pivot < 3; pivot++) {
+			std::size_t best = pivot;
+			for (std::size_t row = pivot + 1; row < 3; row++) {
+				if (std::fabs(normal[row][pivot]) > std::fabs(normal[best][pivot]))
+					best = row;
+			}
+			for (std::size_t column = 0; column < 4; column++)
+				std::swap(normal[pivot][column], normal[best][column]);
+			if (std::fabs(normal[pivot][pivot]) < 1e-300)
+				return;
+			for (std::size_t row = 0; row < 3; row++) {
+				if (row == pivot)
+					continue;
+				double factor = normal[row][pivot] / normal[pivot][pivot];
+				for (std::size_t column = pivot; column < 4; column++)
+					normal[row][column] -= factor * normal[pivot][column];
+			}
+		}
+		for (std::size_t row = 0; row < 3; row++)
+			solution.at(row) = normal[row][3] / normal[row][row];
+
+		bool feasible = true;
+		for (std::size_t term = 0; term < 3; term++) {
+			if (active.at(term) && solution.at(term) < 0) {
+				active.at(term) = false;
+				feasible = false;
+			}
+		}
+		if (feasible)
+			break;
+	}
+
+	std::array<double, 3>& values = coefficients[methodName];
+	for (std::size_t term = 0; term < 3; term++)
+		values.at(term) = active.at(term) && scales.at(term) > 0 ? std::max(solution.at(term), 0.0) / scales.at(term) : 0;
+}
+
+// writes the predicted and the actual runtimes of the given samples into a csv file
+inline
+void
+HGCCostModel::
+writeLog(const std::string& path, const std::vector<Sample>& samples) {
+	std::ofstream log(path);
+	if (!log)
+		throw std::runtime_error("Error! Couldn't open schedule log \"" + path + "\".");
+
+	log << "graph_id_1,graph_id_2,size_term,edge_term,predicted_seconds,actual_seconds\n";
+	for (const Sample& sample : samples)
+		log << sample.graphId1 << "," << sample.graphId2 << "," << sample.terms.at(1) << "," << sample.terms.at(2) << "," << sample.predictedSeconds << "," << sample.actualSeconds << "\n";
+}
+
+#endif /* SRC_HGC_COST_MODEL_IPP_ */
+
+#endif /* SRC_HGC_COST_MODEL_HPP_ */
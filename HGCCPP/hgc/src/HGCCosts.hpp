@@ -1,6 +1,12 @@
 #ifndef SRC_HGC_COSTS_HPP_
 #define SRC_HGC_COSTS_HPP_
 
+#include <unordered_map>
+
+#include "HGCGraphSnapshot.hpp"
+
+// the edit costs of datasets with feature distances. the node factor weighs node against edge operations, the insert/delete factor
+// weighs insertions and deletions against relabelings, so the cost of an edit path is a bilinear function of the two factors.
 template<class UserNodeLabel, class UserEdgeLabel>
 class HGCCosts : public ged::EditCosts<UserNodeLabel, UserEdgeLabel> {
 
@@ -15,6 +21,22 @@ public:
 	virtual double edge_del_cost_fun(const UserEdgeLabel& edge_label) const final;
 	virtual double edge_rel_cost_fun(const UserEdgeLabel& edge_label_1, const UserEdgeLabel& edge_label_2) const final;
 
+	// the parts of the cost of an edit path which don't depend on the factors
+	struct PathTerms {
+		double nodeInsertionsDeletions;
+		double nodeRelabelings;		// the sum of the relabeling costs of the substituted nodes
+		double edgeInsertionsDeletions;
+		double edgeRelabelings;		// the sum of the label differences of the substituted edges
+	};
+
+	void setFactors(double node_factor, double ins_del_factor);
+	double getNodeFactor() const;
+	double getInsertDeleteFactor() const;
+	PathTerms pathTerms(const HGCGraphSnapshot<UserNodeLabel, UserEdgeLabel>& graph1, const HGCGraphSnapshot<UserNodeLabel, UserEdgeLabel>& graph2, const std::vector<int>& nodeMap) const;
+	static double pathCost(const PathTerms& terms, double node_factor, double ins_del_factor);
+
+	std::size_t memoryUsage() const;
+
 private:
 	ged::DMatrix nodeRelabelCosts;
 	double nodeFactor;
@@ -83,6 +105,101 @@ edge_rel_cost_fun(const UserEdgeLabel& edge_label_1, const UserEdgeLabel& edge_l
 	return (1 - insertDeleteFactor) * (1 - nodeFactor) * std::fabs(edge_label_1 - edge_label_2);
 }
 
+template<class UserNodeLabel, class UserEdgeLabel>
+void
+HGCCosts<UserNodeLabel, UserEdgeLabel>::
+setFactors(double node_factor, double ins_del_factor) {
+	nodeFactor = node_factor;
+	insertDeleteFactor = ins_del_factor;
+}
+
+template<class UserNodeLabel, class UserEdgeLabel>
+double
+HGCCosts<UserNodeLabel, UserEdgeLabel>::
+getNodeFactor() const {
+	return nodeFactor;
+}
+
+template<class UserNodeLabel, class UserEdgeLabel>
+double
+HGCCosts<UserNodeLabel, UserEdgeLabel>::
+getInsertDeleteFactor() const {
+	return insertDeleteFactor;
+}
+
+// collects the terms of the edit path induced by the given node map, which contains the image of each node of the first graph or -1
+// if it is deleted. linear in the size of the graphs.
+template<class UserNodeLabel, class UserEdgeLabel>
+typename HGCCosts<UserNodeLabel, UserEdgeLabel>::PathTerms
+HGCCosts<UserNodeLabel, UserEdgeLabel>::
+pathTerms(const HGCGraphSnapshot<UserNodeLabel, UserEdgeLabel>& graph1, const HGCGraphSnapshot<UserNodeLabel, UserEdgeLabel>& graph2, const std::vector<int>& nodeMap) const {
+	PathTerms terms{0, 0, 0, 0};
+
+	// nodes. the unit relabeling cost of labels outside of the cost matrix is 1, as in node_rel_cost_fun.
+	std::vector<bool> substituted(graph2.numberOfNodes(), false);
+	for (std::size_t node = 0; node < graph1.numberOfNodes(); node++) {
+		int image = node < nodeMap.size() ? nodeMap[node] : -1;
+		if (image < 0) {
+			terms.nodeInsertionsDeletions += 1;
+			continue;
+		}
+		substituted.at(static_cast<std::size_t>(image)) = true;
+		UserNodeLabel label1 = graph1.nodeLabels[node];
+		UserNodeLabel label2 = graph2.nodeLabels[static_cast<std::size_t>(image)];
+		if (label1 >= nodeRelabelCosts.num_rows() || label2 >= nodeRelabelCosts.num_cols())
+			terms.nodeRelabelings += 1;
+		else
+			terms.nodeRelabelings += nodeRelabelCosts(label1, label2);
+	}
+	for (bool isSubstituted : substituted)
+		terms.nodeInsertionsDeletions += isSubstituted ? 0 : 1;
+
+	// edges. an edge is substituted if both of its nodes are substituted and their images are adjacent.
+	auto edgeKey = [](std::size_t node1, std::size_t node2) { return (static_cast<std::uint64_t>(std::min(node1, node2)) << 32) | static_cast<std::uint64_t>(std::max(node1, node2)); };
+	std::unordered_map<std::uint64_t, UserEdgeLabel> edges2;
+	edges2.reserve(graph2.numberOfEdges());
+	for (std::size_t node = 0; node < graph2.numberOfNodes(); node++) {
+		for (std::uint32_t edge = graph2.edgeOffsets[node]; edge < graph2.edgeOffsets[node + 1]; edge++)
+			edges2.emplace(edgeKey(node, graph2.edgeTargets[edge]), graph2.edgeLabels[edge]);
+	}
+	std::size_t substitutedEdges = 0;
+	for (std::size_t node = 0; node < graph1.numberOfNodes(); node++) {
+		for (std::uint32_t edge = graph1.edgeOffsets[node]; edge < graph1.edgeOffsets[node + 1]; edge++) {
+			int image1 = node < nodeMap.size() ? nodeMap[node] : -1;
+			int image2 = graph1.edgeTargets[edge] < nodeMap.size() ? nodeMap[graph1.edgeTargets[edge]] : -1;
+			auto edge2 = image1 < 0 || image2 < 0 ? edges2.end() : edges2.find(edgeKey(static_cast<std::size_t>(image1), static_cast<std::size_t>(image2)));
+			if (edge2 == edges2.end()) {
+				terms.edgeInsertionsDeletions += 1;
+				continue;
+			}
+			terms.edgeRelabelings += std::fabs(graph1.edgeLabels[edge] - edge2->second);
+			substitutedEdges++;
+		}
+	}
+	terms.edgeInsertionsDeletions += static_cast<double>(graph2.numberOfEdges() - substitutedEdges);
+
+	return terms;
+}
+
+// returns the cost of an edit path with the given terms under the given factors, in constant time
+template<class UserNodeLabel, class UserEdgeLabel>
+double
+HGCCosts<UserNodeLabel, UserEdgeLabel>::
+pathCost(const PathTerms& terms, double node_factor, double ins_del_factor) {
+	return ins_del_factor * node_factor * terms.nodeInsertionsDeletions
+		   + (1 - ins_del_factor) * node_factor * terms.nodeRelabelings
+		   + ins_del_factor * (1 - node_factor) * terms.edgeInsertionsDeletions
+		   + (1 - ins_del_factor) * (1 - node_factor) * terms.edgeRelabelings;
+}
+
+// returns the bytes of the node relabeling cost matrix, which is quadratic in the number of features
+template<class UserNodeLabel, class UserEdgeLabel>
+std::size_t
+HGCCosts<UserNodeLabel, UserEdgeLabel>::
+memoryUsage() const {
+	return nodeRelabelCosts.num_rows() * nodeRelabelCosts.num_cols() * sizeof(double);
+}
+
 #endif /* SRC_HGC_COSTS_IPP_ */
 
 #endif /* SRC_HGC_COSTS_HPP_ */
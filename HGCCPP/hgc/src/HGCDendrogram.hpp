@@ -0,0 +1,421 @@
+#ifndef SRC_HGC_DENDROGRAM_HPP_
+#define SRC_HGC_DENDROGRAM_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <sstream>
+
+#include "HGCClustering.hpp"
+
+// orders and exports the dendrogram of a clustering in scipy's linkage format. all traversals are iterative, so deep trees (e.g. the
+// chains of single linkage) don't overflow the stack.
+// the leaf ordering minimizes the sum of the distances between adjacent leaves over all orders the dendrogram allows (bar-joseph et
+// al.), like scipy's optimal_ordering. the exact dynamic program needs quadratic memory and up to cubic time in the number of leaves
+// of a subtree, so it is only applied to the subtrees with at most exactThreshold leaves. above them, every merge greedily flips its
+// two children so that their adjacent leaves are closest, which needs a linear number of distances.
+class HGCDendrogram {
+
+public:
+	using DistanceFunction = std::function<double(std::size_t, std::size_t)>;
+
+	// per node, the leaves 0..n-1 first and the cluster created by the i-th merge at n+i. -1 where there is no parent or child.
+	struct Arrays {
+		std::vector<long long> parents;
+		std::vector<long long> leftChildren;
+		std::vector<long long> rightChildren;
+		std::vector<double> heights;			// the merge distance, 0 for leaves
+	};
+
+	static std::vector<std::size_t> optimalLeafOrder(const std::vector<HGCClustering::Merge>& merges, std::size_t numberOfLeaves, const DistanceFunction& distance,
+													 std::size_t exactThreshold, std::size_t numberOfThreads);
+	static std::vector<HGCClustering::Merge> applyLeafOrder(std::vector<HGCClustering::Merge> merges, std::size_t numberOfLeaves, const std::vector<std::size_t>& order);
+	static Arrays toArrays(const std::vector<HGCClustering::Merge>& merges, std::size_t numberOfLeaves);
+	static std::string toNewick(const std::vector<HGCClustering::Merge>& merges, std::size_t numberOfLeaves, const std::vector<std::string>& names);
+	static DistanceFunction rowDistance(const std::vector<std::vector<int>>& matrix);
+
+private:
+	static std::vector<std::size_t> orderExactly(const std::vector<HGCClustering::Merge>& merges, std::size_t numberOfLeaves, std::size_t root,
+												 const std::vector<std::size_t>& sizes, const std::vector<std::size_t>& initialOrder,
+												 const std::vector<std::size_t>& rangeStarts, const DistanceFunction& distance, std::size_t numberOfThreads);
+	static std::string quoteNewickName(const std::string& name);
+
+};
+
+#ifndef SRC_HGC_DENDROGRAM_IPP_
+#define SRC_HGC_DENDROGRAM_IPP_
+
+// the euclidean distance between two rows of the matrix, as the clustering compares the graphs
+inline
+HGCDendrogram::DistanceFunction
+HGCDendrogram::
+rowDistance(const std::vector<std::vector<int>>& matrix) {
+	return [&matrix](std::size_t row1, std::size_t row2) {
+		const std::vector<int>& values1 = matrix.at(row1);
+		const std::vector<int>& values2 = matrix.at(row2);
+		double sum = 0;
+		for (std::size_t column = 0; column < values1.size(); column++) {
+			double difference = static_cast<double>(values1[column]) - static_cast<double>(values2[column]);
+			sum += difference * difference;
+		}
+		return std::sqrt(sum);
+	};
+}
+
+// returns the leaves in the order which minimizes the distances between adjacent leaves (see above)
+inline
+std::vector<std::size_t>
+HGCDendrogram::
+optimalLeafOrder(const std::vector<HGCClustering::Merge>& merges, std::size_t numberOfLeaves, const DistanceFunction& distance, std::size_t exactThreshold,
+				 std::size_t numberOfThreads) {
+	if (numberOfLeaves == 0)
+		return {};
+	if (merges.size() + 1 != numberOfLeaves)
+		throw std::runtime_error("The linkage has " + std::to_string(merges.size()) + " merges, but there are " + std::to_string(numberOfLeaves) + " leaves.");
+	std::size_t numberOfNodes = 2 * numberOfLeaves - 1;
+	std::size_t root = numberOfNodes - 1;
+
+	// sizes and parents of the nodes. the children of a merge have smaller ids, so ascending ids visit the children first.
+	std::vector<std::size_t> sizes(numberOfNodes, 1);
+	std::vector<std::size_t> parents(numberOfNodes, numberOfNodes);
+	for (std::size_t node = numberOfLeaves; node < numberOfNodes; node++) {
+		const HGCClustering::Merge& merge = merges.at(node - numberOfLeaves);
+		if (merge.cluster1 >= node || merge.cluster2 >= node || parents.at(merge.cluster1) != numberOfNodes || parents.at(merge.cluster2) != numberOfNodes)
+			throw std::runtime_error("The linkage is not a valid dendrogram.");
+		sizes.at(node) = sizes.at(merge.cluster1) + sizes.at(merge.cluster2);
+		parents.at(merge.cluster1) = node;
+		parents.at(merge.cluster2) = node;
+	}
+
+	// the leaves of every node form a contiguous range of the initial order, so the leaves of a subtree can be indexed by their offset
+	std::vector<std::size_t> rangeStarts(numberOfNodes, 0);
+	std::vector<std::size_t> initialOrder(numberOfLeaves);
+	for (std::size_t node = root; node >= numberOfLeaves; node--) {
+		const HGCClustering::Merge& merge = merges.at(node - numberOfLeaves);
+		rangeStarts.at(merge.cluster1) = rangeStarts.at(node);
+		rangeStarts.at(merge.cluster2) = rangeStarts.at(node) + sizes.at(merge.cluster1);
+	}
+	for (std::size_t leaf = 0; leaf < numberOfLeaves; leaf++)
+		initialOrder.at(rangeStarts.at(leaf)) = leaf;
+
+	// the maximal subtrees small enough to be ordered exactly. single leaves are trivially exact.
+	std::vector<std::vector<std::size_t>> exactOrders(numberOfNodes);
+	for (std::size_t node = 0; node < numberOfNodes; node++) {
+		if ((sizes.at(node) <= exactThreshold || node < numberOfLeaves) && (node == root || (sizes.at(parents.at(node)) > exactThreshold)))
+			exactOrders.at(node) = node < numberOfLeaves ? std::vector<std::size_t>{node}
+														 : orderExactly(merges, numberOfLeaves, node, sizes, initialOrder, rangeStarts, distance, numberOfThreads);
+	}
+
+	// the greedy orientation of the merges above the exact subtrees, storing the outer leaves of each node and whether its children are flipped
+	std::vector<std::size_t> firstLeaves(numberOfNodes, 0);
+	std::vector<std::size_t> lastLeaves(numberOfNodes, 0);
+	std::vector<bool> flipped1(numberOfNodes, false);
+	std::vector<bool> flipped2(numberOfNodes, false);
+	for (std::size_t node = 0; node < numberOfNodes; node++) {
+		if (!exactOrders.at(node).empty()) {
+			firstLeaves.at(node) = exactOrders.at(node).front();
+			lastLeaves.at(node) = exactOrders.at(node).back();
+			continue;
+		}
+		if (node < numberOfLeaves || sizes.at(node) <= exactThreshold)
+			continue;
+
+		const HGCClustering::Merge& merge = merges.at(node - numberOfLeaves);
+		double bestDistance = std::numeric_limits<double>::infinity();
+		for (int flip1 = 0; flip1 < 2; flip1++) {
+			for (int flip2 = 0; flip2 < 2; flip2++) {
+				std::size_t end1 = flip1 ? firstLeaves.at(merge.cluster1) : lastLeaves.at(merge.cluster1);
+				std::size_t start2 = flip2 ? lastLeaves.at(merge.cluster2) : firstLeaves.at(merge.cluster2);
+				double adjacentDistance = distance(end1, start2);
+				if (adjacentDistance < bestDistance) {
+					bestDistance = adjacentDistance;
+					flipped1.at(node) = flip1 == 1;
+					flipped2.at(node) = flip2 == 1;
+				}
+			}
+		}
+		firstLeaves.at(node) = flipped1.at(node) ? lastLeaves.at(merge.cluster1) : firstLeaves.at(merge.cluster1);
+		lastLeaves.at(node) = flipped2.at(node) ? firstLeaves.at(merge.cluster2) : lastLeaves.at(merge.cluster2);
+	}
+
+	// emits the leaves from the root, tracking whether the current subtree is reversed. the second child is pushed first.
+	std::vector<std::size_t> order;
+	order.reserve(numberOfLeaves);
+	std::vector<std::pair<std::size_t, bool>> stack{{root, false}};
+	while (!stack.empty()) {
+		auto [node, reversed] = stack.back();
+		stack.pop_back();
+		if (!exactOrders.at(node).empty()) {
+			if (reversed)
+				order.insert(order.end(), exactOrders.at(node).rbegin(), exactOrders.at(node).rend());
+			else
+				order.insert(order.end(), exactOrders.at(node).begin(), exactOrders.at(node).end());
+			continue;
+		}
+		const HGCClustering::Merge& merge = merges.at(node - numberOfLeaves);
+		std::pair<std::size_t, bool> first{merge.cluster1, flipped1.at(node) != reversed};
+		std::pair<std::size_t, bool> second{merge.cluster2, flipped2.at(node) != reversed};
+		if (reversed)
+			std::swap(first, second);
+		stack.push_back(second);
+		stack.push_back(first);
+	}
+	return order;
+}
+
+// orders the leaves of the subtree of the given root exactly. m(i, j) is the minimum sum of adjacent distances of an order of the
+// subtree of the lowest common ancestor of the leaves i and j that starts with i and ends with j. since each pair of leaves has a
+// single lowest common ancestor, m fits into one matrix over the leaves of the subtree, which are indexed by their offset in the
+// initial order. for a node with the children a and b, m(i, j) is the minimum of m(i, k) + d(k, l) + m(l, j) over the leaves k of
+// the child of a which doesn't contain i and the leaves l of the child of b which doesn't contain j (k = i and l = j if a or b is a
+// leaf). the optimal order is then traced back from the best pair of outer leaves of the root.
+inline
+std::vector<std::size_t>
+HGCDendrogram::
+orderExactly(const std::vector<HGCClustering::Merge>& merges, std::size_t numberOfLeaves, std::size_t root, const std::vector<std::size_t>& sizes,
+			 const std::vector<std::size_t>& initialOrder, const std::vector<std::size_t>& rangeStarts, const DistanceFunction& distance, std::size_t numberOfThreads) {
+	std::size_t offset = rangeStarts.at(root);
+	std::size_t size = sizes.at(root);
+	numberOfThreads = std::max(numberOfThreads, static_cast<std::size_t>(1));
+
+	// the local range of a node and the local range of the leaves which may be adjacent to the other child if i is the outer leaf
+	auto range = [&](std::size_t node) {
+		std::size_t start = rangeStarts.at(node) - offset;
+		return std::make_pair(start, start + sizes.at(node));
+	};
+	auto innerRange = [&](std::size_t node, std::size_t i) {
+		if (node < numberOfLeaves)
+			return std::make_pair(i, i + 1);
+		const HGCClustering::Merge& merge = merges.at(node - numberOfLeaves);
+		auto range1 = range(merge.cluster1);
+		return i < range1.second ? range(merge.cluster2) : range1;
+	};
+
+	// the distances between the leaves of the subtree, with the rows distributed over the threads
+	std::vector<double> distances(size * size, 0);
+	std::atomic<std::size_t> nextRow{0};
+	auto distanceWorker = [&]() {
+		for (std::size_t i = nextRow++; i < size; i = nextRow++) {
+			for (std::size_t j = i + 1; j < size; j++) {
+				distances[i * size + j] = distance(initialOrder.at(offset + i), initialOrder.at(offset + j));
+				distances[j * size + i] = distances[i * size + j];
+			}
+		}
+	};
+	std::vector<std::thread> threads;
+	for (std::size_t thread = 1; thread < std::min(numberOfThreads, size); thread++)
+		threads.emplace_back(distanceWorker);
+	distanceWorker();
+	for (std::thread& thread : threads)
+		thread.join();
+	threads.clear();
+
+	// the internal nodes of the subtree in ascending order, so the children come first
+	std::vector<std::size_t> nodes;
+	std::vector<std::size_t> stack{root};
+	while (!stack.empty()) {
+		std::size_t node = stack.back();
+		stack.pop_back();
+		if (node < numberOfLeaves)
+			continue;
+		nodes.emplace_back(node);
+		stack.emplace_back(merges.at(node - numberOfLeaves).cluster1);
+		stack.emplace_back(merges.at(node - numberOfLeaves).cluster2);
+	}
+	std::sort(nodes.begin(), nodes.end());
+
+	std::vector<double> costs(size * size, 0);
+	for (std::size_t node : nodes) {
+		const HGCClustering::Merge& merge = merges.at(node - numberOfLeaves);
+		auto range1 = range(merge.cluster1);
+		auto range2 = range(merge.cluster2);
+
+		// the outer leaves i of the first child are distributed over the threads if the node is large enough to pay off
+		std::atomic<std::size_t> nextI{range1.first};
+		auto costWorker = [&]() {
+			std::vector<double> viaK(size, 0);	// min over k of m(i, k) + d(k, l), per leaf l of the second child
+			for (std::size_t i = nextI++; i < range1.second; i = nextI++) {
+				auto inner1 = innerRange(merge.cluster1, i);
+				for (std::size_t l = range2.first; l < range2.second; l++) {
+					double best = std::numeric_limits<double>::infinity();
+					for (std::size_t k = inner1.first; k < inner1.second; k++)
+						best = std::min(best, costs[i * size + k] + distances[k * size + l]);
+					viaK[l] = best;
+				}
+				for (std::size_t j = range2.first; j < range2.second; j++) {
+					auto inner2 = innerRange(merge.cluster2, j);
+					double best = std::numeric_limits<double>::infinity();
+					for (std::size_t l = inner2.first; l < inner2.second; l++)
+						best = std::min(best, viaK[l] + costs[l * size + j]);
+					costs[i * size + j] = best;
+					costs[j * size + i] = best;
+				}
+			}
+		};
+		std::size_t workers = (range1.second - range1.first) * (range2.second - range2.first) >= 4096 ? std::min(numberOfThreads, range1.second - range1.first) : 1;
+		for (std::size_t thread = 1; thread < workers; thread++)
+			threads.emplace_back(costWorker);
+		costWorker();
+		for (std::thread& thread : threads)
+			thread.join();
+		threads.clear();
+	}
+
+	// the best outer leaves of the root
+	std::size_t bestFirst = 0;
+	std::size_t bestLast = 0;
+	if (root >= numberOfLeaves) {
+		auto range1 = range(merges.at(root - numberOfLeaves).cluster1);
+		auto range2 = range(merges.at(root - numberOfLeaves).cluster2);
+		double bestCost = std::numeric_limits<double>::infinity();
+		for (std::size_t i = range1.first; i < range1.second; i++) {
+			for (std::size_t j = range2.first; j < range2.second; j++) {
+				if (costs[i * size + j] < bestCost) {
+					bestCost = costs[i * size + j];
+					bestFirst = i;
+					bestLast = j;
+				}
+			}
+		}
+	}
+
+	// traces the order back, emitting the part of each node from first to last. the part of the child containing first is pushed last.
+	std::vector<std::size_t> order;
+	order.reserve(size);
+	std::vector<std::tuple<std::size_t, std::size_t, std::size_t>> parts{{root, bestFirst, bestLast}};
+	while (!parts.empty()) {
+		auto [node, first, last] = parts.back();
+		parts.pop_back();
+		if (node < numberOfLeaves) {
+			order.emplace_back(initialOrder.at(offset + first));
+			continue;
+		}
+		const HGCClustering::Merge& merge = merges.at(node - numberOfLeaves);
+		std::size_t firstChild = merge.cluster1;
+		std::size_t lastChild = merge.cluster2;
+		auto range1 = range(firstChild);
+		if (first < range1.first || first >= range1.second)
+			std::swap(firstChild, lastChild);
+
+		auto innerFirst = innerRange(firstChild, first);
+		auto innerLast = innerRange(lastChild, last);
+		double bestCost = std::numeric_limits<double>::infinity();
+		std::size_t bestK = first;
+		std::size_t bestL = last;
+		for (std::size_t k = innerFirst.first; k < innerFirst.second; k++) {
+			for (std::size_t l = innerLast.first; l < innerLast.second; l++) {
+				double cost = costs[first * size + k] + distances[k * size + l] + costs[l * size + last];
+				if (cost < bestCost) {
+					bestCost = cost;
+					bestK = k;
+					bestL = l;
+				}
+			}
+		}
+		parts.emplace_back(lastChild, bestL, last);
+		parts.emplace_back(firstChild, first, bestK);
+	}
+	return order;
+}
+
+// swaps the children of the merges so that the first child holds the leaves which come first in the given order, as scipy's
+// optimal_leaf_ordering does. the dendrogram then draws the leaves in that order. the order has to be compatible with the dendrogram.
+inline
+std::vector<HGCClustering::Merge>
+HGCDendrogram::
+applyLeafOrder(std::vector<HGCClustering::Merge> merges, std::size_t numberOfLeaves, const std::vector<std::size_t>& order) {
+	if (order.size() != numberOfLeaves || merges.size() + 1 != std::max(numberOfLeaves, static_cast<std::size_t>(1)))
+		throw std::runtime_error("The leaf order doesn't belong to the linkage.");
+	std::vector<std::size_t> firstPositions(numberOfLeaves + merges.size(), 0);
+	for (std::size_t position = 0; position < order.size(); position++)
+		firstPositions.at(order.at(position)) = position;
+	for (std::size_t step = 0; step < merges.size(); step++) {
+		HGCClustering::Merge& merge = merges.at(step);
+		if (firstPositions.at(merge.cluster1) > firstPositions.at(merge.cluster2))
+			std::swap(merge.cluster1, merge.cluster2);
+		firstPositions.at(numberOfLeaves + step) = firstPositions.at(merge.cluster1);
+	}
+	return merges;
+}
+
+// converts the linkage into flat arrays of the parent, the children and the height of every node
+inline
+HGCDendrogram::Arrays
+HGCDendrogram::
+toArrays(const std::vector<HGCClustering::Merge>& merges, std::size_t numberOfLeaves) {
+	std::size_t numberOfNodes = numberOfLeaves + merges.size();
+	Arrays arrays;
+	arrays.parents.assign(numberOfNodes, -1);
+	arrays.leftChildren.assign(numberOfNodes, -1);
+	arrays.rightChildren.assign(numberOfNodes, -1);
+	arrays.heights.assign(numberOfNodes, 0);
+	for (std::size_t step = 0; step < merges.size(); step++) {
+		const HGCClustering::Merge& merge = merges.at(step);
+		std::size_t node = numberOfLeaves + step;
+		if (merge.cluster1 >= node || merge.cluster2 >= node)
+			throw std::runtime_error("The linkage is not a valid dendrogram.");
+		arrays.parents.at(merge.cluster1) = static_cast<long long>(node);
+		arrays.parents.at(merge.cluster2) = static_cast<long long>(node);
+		arrays.leftChildren.at(node) = static_cast<long long>(merge.cluster1);
+		arrays.rightChildren.at(node) = static_cast<long long>(merge.cluster2);
+		arrays.heights.at(node) = merge.distance;
+	}
+	return arrays;
+}
+
+// quotes a leaf name if it contains characters with a meaning in newick, doubling the quotes inside
+inline
+std::string
+HGCDendrogram::
+quoteNewickName(const std::string& name) {
+	if (name.find_first_of(" \t\n()[]':;,") == std::string::npos)
+		return name;
+	std::string quoted = "'";
+	for (char character : name) {
+		quoted += character;
+		if (character == '\'')
+			quoted += '\'';
+	}
+	return quoted + "'";
+}
+
+// writes the dendrogram in the newick format. the branch lengths are the differences of the heights, the leaves are named by the
+// given names or by their ids if none are given.
+inline
+std::string
+HGCDendrogram::
+toNewick(const std::vector<HGCClustering::Merge>& merges, std::size_t numberOfLeaves, const std::vector<std::string>& names) {
+	if (!names.empty() && names.size() != numberOfLeaves)
+		throw std::runtime_error("There are " + std::to_string(names.size()) + " leaf names for " + std::to_string(numberOfLeaves) + " leaves.");
+	if (numberOfLeaves == 0)
+		return ";";
+	Arrays arrays = toArrays(merges, numberOfLeaves);
+	std::size_t root = arrays.parents.size() - 1;
+
+	std::ostringstream newick;
+	newick.precision(10);
+	// the phase of a node counts its children which have been written
+	std::vector<std::pair<std::size_t, int>> stack{{root, 0}};
+	while (!stack.empty()) {
+		auto [node, phase] = stack.back();
+		stack.pop_back();
+		if (node >= numberOfLeaves && phase < 2) {
+			newick << (phase == 0 ? "(" : ",");
+			stack.emplace_back(node, phase + 1);
+			stack.emplace_back(static_cast<std::size_t>(phase == 0 ? arrays.leftChildren.at(node) : arrays.rightChildren.at(node)), 0);
+			continue;
+		}
+		if (node >= numberOfLeaves)
+			newick << ")";
+		else
+			newick << quoteNewickName(names.empty() ? std::to_string(node) : names.at(node));
+		if (node != root)
+			newick << ":" << arrays.heights.at(static_cast<std::size_t>(arrays.parents.at(node))) - arrays.heights.at(node);
+	}
+	newick << ";";
+	return newick.str();
+}
+
+#endif /* SRC_HGC_DENDROGRAM_IPP_ */
+
+#endif /* SRC_HGC_DENDROGRAM_HPP_ */
@@ -0,0 +1,135 @@
+#ifndef SRC_HGC_FEATURE_FILTER_HPP_
+#define SRC_HGC_FEATURE_FILTER_HPP_
+
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+
+// selects the features of the omics matrix which are turned into nodes, before the logratio aggregates and the bins are computed.
+// rare and nearly constant features inflate both the quadratic logratio pass and the graph sizes, but hardly change the distances.
+// the samples can first be normalized to relative abundances, then features are removed which are present in too few samples or
+// whose mean abundance is too low, and finally only the features with the highest variance are kept.
+class HGCFeatureFilter {
+
+public:
+	HGCFeatureFilter();
+	virtual ~HGCFeatureFilter();
+
+	void configure(double minimumPrevalence, double minimumMeanAbundance, std::size_t topKByVariance, bool relativeAbundance);
+	bool isActive() const;
+	std::vector<std::size_t> apply(ged::DMatrix& matrix) const;
+	std::string describe() const;
+
+private:
+	double minimumPrevalence;		// fraction of the samples in which a feature has to be present
+	double minimumMeanAbundance;
+	std::size_t topKByVariance;		// 0 keeps all features
+	bool relativeAbundance;
+
+};
+
+#ifndef SRC_HGC_FEATURE_FILTER_IPP_
+#define SRC_HGC_FEATURE_FILTER_IPP_
+
+inline
+HGCFeatureFilter::
+HGCFeatureFilter():
+	minimumPrevalence{0},
+	minimumMeanAbundance{0},
+	topKByVariance{0},
+	relativeAbundance{false} {
+}
+
+inline
+HGCFeatureFilter::
+~HGCFeatureFilter() = default;
+
+inline
+void
+HGCFeatureFilter::
+configure(double minimumPrevalence, double minimumMeanAbundance, std::size_t topKByVariance, bool relativeAbundance) {
+	if (minimumPrevalence < 0 || minimumPrevalence > 1)
+		throw std::runtime_error("The minimum prevalence has to be a fraction of the samples between 0 and 1.");
+	if (minimumMeanAbundance < 0)
+		throw std::runtime_error("The minimum mean abundance must not be negative.");
+	this->minimumPrevalence = minimumPrevalence;
+	this->minimumMeanAbundance = minimumMeanAbundance;
+	this->topKByVariance = topKByVariance;
+	this->relativeAbundance = relativeAbundance;
+}
+
+inline
+bool
+HGCFeatureFilter::
+isActive() const {
+	return minimumPrevalence > 0 || minimumMeanAbundance > 0 || topKByVariance > 0 || relativeAbundance;
+}
+
+// normalizes the samples (rows) of the matrix in place if requested and returns the ids of the kept features (columns) in ascending order
+inline
+std::vector<std::size_t>
+HGCFeatureFilter::
+apply(ged::DMatrix& matrix) const {
+	std::size_t numberOfSamples = matrix.num_rows();
+	std::size_t numberOfFeatures = matrix.num_cols();
+
+	if (relativeAbundance) {
+		for (std::size_t sample = 0; sample < numberOfSamples; sample++) {
+			double total = 0;
+			for (std::size_t feature = 0; feature < numberOfFeatures; feature++)
+				total += matrix(sample, feature);
+			if (total <= 0)
+				continue;
+			for (std::size_t feature = 0; feature < numberOfFeatures; feature++)
+				matrix(sample, feature) /= total;
+		}
+	}
+
+	std::vector<std::size_t> kept;
+	std::vector<double> variances(numberOfFeatures, 0);
+	for (std::size_t feature = 0; feature < numberOfFeatures; feature++) {
+		std::size_t present = 0;
+		double mean = 0;
+		for (std::size_t sample = 0; sample < numberOfSamples; sample++) {
+			present += matrix(sample, feature) > 0 ? 1 : 0;
+			mean += matrix(sample, feature);
+		}
+		mean /= static_cast<double>(std::max(numberOfSamples, static_cast<std::size_t>(1)));
+		if (static_cast<double>(present) < minimumPrevalence * static_cast<double>(numberOfSamples) || mean < minimumMeanAbundance)
+			continue;
+
+		for (std::size_t sample = 0; sample < numberOfSamples; sample++)
+			variances.at(feature) += (matrix(sample, feature) - mean) * (matrix(sample, feature) - mean);
+		variances.at(feature) /= static_cast<double>(std::max(numberOfSamples, static_cast<std::size_t>(1)));
+		kept.emplace_back(feature);
+	}
+
+	// ties are broken by the feature id, so the selection doesn't depend on the sort implementation
+	if (topKByVariance > 0 && kept.size() > topKByVariance) {
+		std::stable_sort(kept.begin(), kept.end(), [&variances](std::size_t a, std::size_t b) { return variances.at(a) > variances.at(b); });
+		kept.resize(topKByVariance);
+		std::sort(kept.begin(), kept.end());
+	}
+	return kept;
+}
+
+// describes the configured filter steps for the load summary
+inline
+std::string
+HGCFeatureFilter::
+describe() const {
+	std::vector<std::string> steps;
+	if (relativeAbundance)
+		steps.emplace_back("relative abundance");
+	if (minimumPrevalence > 0)
+		steps.emplace_back("prevalence >= " + std::to_string(minimumPrevalence));
+	if (minimumMeanAbundance > 0)
+		steps.emplace_back("mean abundance >= " + std::to_string(minimumMeanAbundance));
+	if (topKByVariance > 0)
+		steps.emplace_back("top " + std::to_string(topKByVariance) + " by variance");
+	return std::accumulate(steps.begin(), steps.end(), std::string(), [](const std::string& a, const std::string& b) { return a.empty() ? b : a + ", " + b; });
+}
+
+#endif /* SRC_HGC_FEATURE_FILTER_IPP_ */
+
+#endif /* SRC_HGC_FEATURE_FILTER_HPP_ */
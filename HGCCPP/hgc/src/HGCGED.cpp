@@ -20,11 +20,55 @@ void showWarning(const std::string& message) {
 	std::cout << "Warning! " + message << std::endl;
 }
 
+// prints the progress of a computation to the console, overwriting the previous progress output
+void showProgress(float percentage) {
+	std::cout << "\033[A\33[KProgress: " + std::to_string(percentage) + "%" << std::endl;
+}
+
 // throws an error with a given console output
 void throwError(const std::string& message, const std::string& details) {
 	throw std::runtime_error("Error! " + message + " " + details);
 }
 
+// returns the peak resident set size of the process in bytes. since the last call of resetPeakResidentSetSize() if supported by the kernel.
+std::size_t readPeakResidentSetSize() {
+	std::ifstream status("/proc/self/status");
+	std::string line;
+	while (std::getline(status, line)) {
+		if (line.compare(0, 6, "VmHWM:") == 0)
+			return static_cast<std::size_t>(std::stoull(line.substr(6))) * 1024;	// the value is given in kB
+	}
+
+	struct rusage usage{};
+	getrusage(RUSAGE_SELF, &usage);
+	return static_cast<std::size_t>(usage.ru_maxrss) * 1024;
+}
+
+// returns the current resident set size of the process in bytes, or 0 if it can't be read
+std::size_t readResidentSetSize() {
+	std::ifstream status("/proc/self/status");
+	std::string line;
+	while (std::getline(status, line)) {
+		if (line.compare(0, 6, "VmRSS:") == 0)
+			return static_cast<std::size_t>(std::stoull(line.substr(6))) * 1024;	// the value is given in kB
+	}
+	return 0;
+}
+
+// formats a number of bytes in MiB for the console output
+std::string toMebibytes(std::size_t bytes) {
+	return std::to_string(bytes / (1024 * 1024)) + " MiB";
+}
+
+// resets the peak resident set size of the process to its current resident set size. returns false if not supported.
+bool resetPeakResidentSetSize() {
+	std::ofstream clearRefs("/proc/self/clear_refs");
+	if (!clearRefs)
+		return false;
+	clearRefs << "5";
+	return static_cast<bool>(clearRefs.flush());
+}
+
 // filters out the argument "--threads" of the method arguments and returns its passed value, e.g. "--threads 10" returns 10.
 int parseMethodThread(const std::string& methodArgumentsString) {
 	int value = -1;
@@ -47,17 +91,40 @@ int parseMethodThread(const std::string& methodArgumentsString) {
 	return value;
 }
 
-// parses the init type string into the ged init type enum
-ged::Options::InitType parseInitType(const std::string& initTypeString) {
-	if (initTypeString.empty()) {
-		showInfo("No initialization type passed. Defaulting to \"LAZY\".");
-		return ged::Options::InitType::LAZY_WITHOUT_SHUFFLED_COPIES;
+// removes the given argument and its value from the method arguments, e.g. "--iterations 10 --optimal TRUE" without "--iterations"
+// returns "--optimal TRUE".
+std::string removeMethodArgument(const std::string& methodArgumentsString, const std::string& argument) {
+	std::string result;
+	std::string option = argument + " ";
+	std::size_t length = option.size();
+	std::size_t index = 0;
+	while (index < methodArgumentsString.size()) {
+		if (methodArgumentsString.compare(index, length, option) == 0) {
+			index += length;
+			while (index < methodArgumentsString.size() && methodArgumentsString.at(index) != ' ')
+				index++;
+			while (index < methodArgumentsString.size() && methodArgumentsString.at(index) == ' ')
+				index++;
+			continue;
+		}
+		result += methodArgumentsString.at(index);
+		index++;
 	}
-	else if (initTypeString == "LAZY")
-		return ged::Options::InitType::LAZY_WITHOUT_SHUFFLED_COPIES;
-	else if (initTypeString == "EAGER")
-		return ged::Options::InitType::EAGER_WITHOUT_SHUFFLED_COPIES;
-	else
+	while (!result.empty() && result.back() == ' ')
+		result.pop_back();
+	return result;
+}
+
+// removes the argument "--threads" and its value from the method arguments, e.g. "--threads 10 --optimal TRUE" returns "--optimal TRUE".
+std::string removeMethodThread(const std::string& methodArgumentsString) {
+	return removeMethodArgument(methodArgumentsString, "--threads");
+}
+
+// checks the init type string. the solver contexts initialize every pair lazily, so "EAGER" is deprecated and has no effect.
+void checkInitType(const std::string& initTypeString) {
+	if (initTypeString == "EAGER")
+		showWarning("The initialization type \"EAGER\" is deprecated and ignored. The graphs are always initialized lazily per solved pair.");
+	else if (!initTypeString.empty() && initTypeString != "LAZY")
 		throwError("Couldn't construct HGC Environment:", "\"" + initTypeString + "\" is an invalid initialization type.");
 }
 
@@ -88,6 +155,95 @@ bool HGCGED::isSampleGraph(ged::GEDGraph::GraphID graphId) {
 	return graphId < sampleNamesToFeatures.size();
 }
 
+// returns the edit costs in use or a null pointer if the constant edit costs of gedlib are used
+ged::EditCosts<HGCNodeLabel, HGCEdgeLabel>* HGCGED::getEditCosts() {
+	if (editCostsName == "dataset")
+		return datasetEditCosts;
+	else if (editCostsName == "custom")
+		return customEditCosts;
+	return nullptr;
+}
+
+// brings the snapshots up to date with the ged environment. only the graphs which were added or modified since the last update are
+// copied, in parallel by the workers, each into its own arena. once most snapshots are outdated, all of them are rebuilt, which
+// releases the memory of the replaced ones.
+void HGCGED::updateGraphSnapshots() {
+	std::size_t numberOfGraphs = ged_->num_graphs();
+	std::vector<std::size_t> graphIds;
+	for (std::size_t graphId : modifiedGraphs) {
+		if (graphId < snapshots.size())
+			graphIds.emplace_back(graphId);
+	}
+	for (std::size_t graphId = snapshots.size(); graphId < numberOfGraphs; graphId++)
+		graphIds.emplace_back(graphId);
+	modifiedGraphs.clear();
+	if (graphIds.empty())
+		return;
+
+	if (2 * graphIds.size() >= numberOfGraphs) {
+		snapshots.clear();
+		snapshotArenas.clear();
+		graphIds.resize(numberOfGraphs);
+		std::iota(graphIds.begin(), graphIds.end(), 0);
+	}
+
+	// the workers only read the ged environment
+	std::size_t workers = std::max(std::min(numberOfWorkers, graphIds.size()), static_cast<std::size_t>(1));
+	std::size_t firstArena = snapshotArenas.size();
+	for (std::size_t worker = 0; worker < workers; worker++)
+		snapshotArenas.emplace_back(std::make_unique<std::pmr::monotonic_buffer_resource>());
+
+	std::vector<std::optional<HGCGraphSnapshot<HGCNodeLabel, HGCEdgeLabel>>> updatedSnapshots(numberOfGraphs);
+	std::vector<std::exception_ptr> errors(workers);
+	std::atomic<std::size_t> nextGraph{0};
+	auto takeSnapshots = [this, &graphIds, &updatedSnapshots, &errors, &nextGraph, firstArena](std::size_t worker) {
+		try {
+			std::pmr::memory_resource* resource = snapshotArenas.at(firstArena + worker).get();
+			for (std::size_t index = nextGraph++; index < graphIds.size(); index = nextGraph++) {
+				std::size_t graphId = graphIds.at(index);
+				ged::ExchangeGraph<HGCNodeId, HGCNodeLabel, HGCEdgeLabel> graph = ged_->get_graph(graphId, false, false, true);
+				HGCGraphSnapshot<HGCNodeLabel, HGCEdgeLabel>& snapshot = updatedSnapshots.at(graphId).emplace(resource);
+				snapshot.assign(graph.node_labels, graph.edge_list);
+				snapshot.computeCanonicalHash();
+			}
+		}
+		catch (...) {
+			errors.at(worker) = std::current_exception();
+			nextGraph = graphIds.size();
+		}
+	};
+	std::vector<std::thread> threads;
+	for (std::size_t worker = 1; worker < workers; worker++)
+		threads.emplace_back(takeSnapshots, worker);
+	takeSnapshots(0);
+	for (std::thread& thread : threads)
+		thread.join();
+	for (const std::exception_ptr& error : errors) {
+		if (error)
+			std::rethrow_exception(error);
+	}
+
+	// moving keeps every snapshot in the arena it was built in
+	std::vector<HGCGraphSnapshot<HGCNodeLabel, HGCEdgeLabel>> mergedSnapshots;
+	mergedSnapshots.reserve(numberOfGraphs);
+	for (std::size_t graphId = 0; graphId < numberOfGraphs; graphId++) {
+		if (updatedSnapshots.at(graphId))
+			mergedSnapshots.emplace_back(std::move(*updatedSnapshots.at(graphId)));
+		else
+			mergedSnapshots.emplace_back(std::move(snapshots.at(graphId)));
+	}
+	snapshots = std::move(mergedSnapshots);
+
+	// the snapshots hold the distinct edges gedlib stored, so they correct the counts of addEdge, which can't tell if gedlib ignored
+	// an edge as a duplicate
+	storedNodes = 0;
+	storedEdges = 0;
+	for (const HGCGraphSnapshot<HGCNodeLabel, HGCEdgeLabel>& snapshot : snapshots) {
+		storedNodes += snapshot.numberOfNodes();
+		storedEdges += snapshot.numberOfEdges();
+	}
+}
+
 #pragma endregion
 
 #pragma region setup
@@ -95,14 +251,36 @@ bool HGCGED::isSampleGraph(ged::GEDGraph::GraphID graphId) {
 // constructs the HGCGEDExec environment
 HGCGED::HGCGED(const std::string& methodString, const std::string& methodArguments, bool useCustomEditCosts, const std::string& initTypeString):
 	customEditCosts{nullptr},
-	datasetEditCosts{nullptr} {
+	datasetEditCosts{nullptr},
+	storedNodes{0},
+	storedEdges{0},
+	peakMemoryUsage{0},
+	labelsOutdated{true},
+	methodArguments{methodArguments},
+	numberOfWorkers{static_cast<std::size_t>(std::max(parseMethodThread(methodArguments), 1))},
+	distancesOnly{true},
+	deduplicate{true},
+	dispatchCustomCosts{true},
+	sparsificationMode{"none"},
+	sparsificationValue{0},
+	pairTimeLimit{0},
+	pairIterationLimit{0},
+	memoryBudget{0},
+	costNodeFactor{0.5},
+	costInsertDeleteFactor{0.5},
+	nextRow{0},
+	computedPairs{0},
+	cancelRequested{false},
+	computeRunning{false},
+	peakResettable{false},
+	sampleStride{1} {
 
 	// ged env setup
-	ged_ = new ged::GEDEnv<std::size_t, std::size_t, double>;
+	ged_ = new ged::GEDEnv<HGCNodeId, HGCNodeLabel, HGCEdgeLabel>;
 
 	// edit costs
 	if (useCustomEditCosts) {
-		customEditCosts = new UserDefined<std::size_t, double>();
+		customEditCosts = new UserDefined<HGCNodeLabel, HGCEdgeLabel>();
 		ged_->set_edit_costs(customEditCosts);
 		editCostsName = "custom";
 	}
@@ -111,13 +289,13 @@ HGCGED::HGCGED(const std::string& methodString, const std::string& methodArgumen
 		editCostsName = "constant";
 	}
 
-	// init type
-	ged_->init(parseInitType(initTypeString));
+	// init type. the environment only stores the graphs, which the solver contexts copy and initialize lazily per pair, so it is
+	// never initialized itself.
+	checkInitType(initTypeString);
 
 	// method
 	ged::Options::GEDMethod method = loadMethod(methodString);
 	ged_->set_method(method, methodArguments);
-	ged_->init_method();
 	if (customEditCosts)
 		customEditCosts->multiThreaded = (parseMethodThread(methodArguments) > 1);
 
@@ -125,6 +303,17 @@ HGCGED::HGCGED(const std::string& methodString, const std::string& methodArgumen
 
 // destructs HGCGEDExec environment
 HGCGED::~HGCGED() {
+	if (computeThread.joinable()) {
+		cancelRequested = true;
+
+		// python deletes the environment with the gil held, which the background thread may be waiting for to evaluate custom edit costs
+		if (Py_IsInitialized() && PyGILState_Check()) {
+			pybind11::gil_scoped_release release;
+			computeThread.join();
+		}
+		else
+			computeThread.join();
+	}
 	delete ged_;
 	delete customEditCosts;
 	delete datasetEditCosts;
@@ -137,10 +326,16 @@ HGCGED::~HGCGED() {
 // gets an omics dataset with an optional costs dataset, parses them and creates ged graphs and edit costs out of them
 void HGCGED::loadOmicsData(const std::string& omicsDatasetPath, const std::string& associatedCostsDatasetPath = "", char separator = ',') {
 
-	auto* ged = new ged::GEDEnv<std::size_t, std::size_t, double>();
+	if (computeRunning)
+		throwError("Couldn't load omics data:", "A computation is still running.");
+
+	// the new environment only replaces the current one once the data is loaded, so that a failed load leaves the environment as it was
+	std::unique_ptr<ged::GEDEnv<HGCNodeId, HGCNodeLabel, HGCEdgeLabel>> ged = std::make_unique<ged::GEDEnv<HGCNodeId, HGCNodeLabel, HGCEdgeLabel>>();
 
 	#pragma region parse omics dataset
 
+	HGC_TRACE_BEGIN(parseSpan, "csv parsing");
+
 	dicoda::CSVParser csvParser;
 	csvParser.parse(omicsDatasetPath, separator);
 
@@ -162,10 +357,19 @@ void HGCGED::loadOmicsData(const std::string& omicsDatasetPath, const std::strin
 		throwError("Couldn't load omics data:", "Duplicate feature names in \"" + omicsDatasetPath + "\".");
 	}
 
+	// feature ids are used as node labels
+	if (featureNamesSet.size() > std::numeric_limits<HGCNodeLabel>::max()) {
+		throwError("Couldn't load omics data:", "Too many features in \"" + omicsDatasetPath + "\" for the node label type, rebuild with HGC_WIDE_LABELS.");
+	}
+
+	HGC_TRACE_END(parseSpan);
+
 	#pragma endregion
 
 	#pragma region add new omics data to existing omics data
 
+	HGC_TRACE_BEGIN(addSpan, "add omics data");
+
 	std::size_t firstNonSampleGraphId = sampleNamesToFeatures.size();
 
 	// ensuring the exact same features names
@@ -179,12 +383,29 @@ void HGCGED::loadOmicsData(const std::string& omicsDatasetPath, const std::strin
 		}
 	}
 
-	// add the samples to the current omics data
+	// add the samples to the current omics data. the added and the overwritten samples are remembered, so that the samples can be
+	// restored if the data turns out invalid or too large before the graphs are built.
+	std::vector<std::string> addedSampleNames;
+	std::map<std::string, std::map<std::string, double>> overwrittenSamples;
+	struct SampleRestorer {
+		std::function<void()> restore;
+		~SampleRestorer() {
+			if (restore)
+				restore();
+		}
+	} sampleRestorer{[this, &addedSampleNames, &overwrittenSamples]() {
+		for (const std::string& sampleName : addedSampleNames)
+			sampleNamesToFeatures.erase(sampleName);
+		for (std::pair<const std::string, std::map<std::string, double>>& sample : overwrittenSamples)
+			sampleNamesToFeatures.emplace(sample.first, std::move(sample.second));
+	}};
 	for (std::size_t rowIndex = 1; rowIndex < csvParser.num_rows(); rowIndex++) {
 		const std::string& sampleName = csvParser.cell(rowIndex, 0);
-		if (sampleNamesToFeatures.find(sampleName) != sampleNamesToFeatures.end()) {
+		auto existingSample = sampleNamesToFeatures.find(sampleName);
+		if (existingSample != sampleNamesToFeatures.end()) {
 			showWarning("HGC Environment already contains a sample with name \"" + sampleName + "\"! It will be overwritten.");
-			sampleNamesToFeatures.erase(sampleName);
+			overwrittenSamples.emplace(sampleName, std::move(existingSample->second));
+			sampleNamesToFeatures.erase(existingSample);
 		}
 
 		std::map<std::string, double> featureNamesToFeatureValues;
@@ -203,14 +424,19 @@ void HGCGED::loadOmicsData(const std::string& omicsDatasetPath, const std::strin
 			featureNamesToFeatureValues.emplace(featureName, featureValue);
 		}
 		sampleNamesToFeatures.emplace(sampleName, featureNamesToFeatureValues);
+		addedSampleNames.emplace_back(sampleName);
 	}
 
+	HGC_TRACE_END(addSpan);
+
 	#pragma endregion
 
 	#pragma region reconstruct sample graphs into new ged environment
 
 	#pragma region setup id-based sample & feature storage
 
+	HGC_TRACE_BEGIN(storageSpan, "sample storage");
+
 	std::vector<std::string> sampleNames;
 	std::vector<std::string> featureNames;
 	ged::DMatrix omicsDataMatrix = ged::DMatrix(sampleNamesToFeatures.size(), sampleNamesToFeatures.begin()->second.size());
@@ -243,10 +469,82 @@ void HGCGED::loadOmicsData(const std::string& omicsDatasetPath, const std::strin
 		sampleIterator++;
 	}
 
+	HGC_TRACE_END(storageSpan);
+
+	#pragma endregion
+
+	#pragma region filter features
+
+	// the removed features are neither nodes nor part of the logratio aggregates and the bins. the feature ids, which are the node
+	// labels, are renumbered over the kept features.
+	std::unordered_set<std::string> filteredFeatureNames;
+	std::map<std::string, std::size_t> newFeatureFilterStatistics;
+	if (featureFilter.isActive()) {
+		HGC_TRACE_SCOPE("feature filter");
+
+		std::size_t nodesBefore = 0;
+		for (std::size_t sample_id{0}; sample_id < sampleNames.size(); sample_id++) {
+			for (std::size_t feature_id{0}; feature_id < featureNames.size(); feature_id++)
+				nodesBefore += isNodeMatrix(sample_id, feature_id) ? 1 : 0;
+		}
+
+		std::vector<std::size_t> keptFeatureIds = featureFilter.apply(omicsDataMatrix);
+		if (keptFeatureIds.empty())
+			throwError("Couldn't load omics data:", "The feature filter (" + featureFilter.describe() + ") removed all features.");
+
+		ged::DMatrix filteredOmicsDataMatrix = ged::DMatrix(sampleNames.size(), keptFeatureIds.size());
+		ged::Matrix<bool> filteredIsNodeMatrix = ged::Matrix<bool>(sampleNames.size(), keptFeatureIds.size());
+		std::vector<std::string> filteredFeatureNamesInOrder;
+		std::size_t nodesAfter = 0;
+		for (std::size_t feature_id{0}; feature_id < keptFeatureIds.size(); feature_id++) {
+			std::size_t originalFeatureId = keptFeatureIds.at(feature_id);
+			filteredFeatureNamesInOrder.emplace_back(featureNames.at(originalFeatureId));
+			for (std::size_t sample_id{0}; sample_id < sampleNames.size(); sample_id++) {
+				filteredOmicsDataMatrix(sample_id, feature_id) = omicsDataMatrix(sample_id, originalFeatureId);
+				filteredIsNodeMatrix(sample_id, feature_id) = omicsDataMatrix(sample_id, originalFeatureId) > 0;
+				nodesAfter += filteredIsNodeMatrix(sample_id, feature_id) ? 1 : 0;
+			}
+		}
+		std::size_t featuresBefore = featureNames.size();
+		std::size_t featuresAfter = keptFeatureIds.size();
+		filteredFeatureNames.insert(featureNames.begin(), featureNames.end());
+		for (const std::string& featureName : filteredFeatureNamesInOrder)
+			filteredFeatureNames.erase(featureName);
+		omicsDataMatrix = std::move(filteredOmicsDataMatrix);
+		isNodeMatrix = std::move(filteredIsNodeMatrix);
+		featureNames = std::move(filteredFeatureNamesInOrder);
+
+		// a model estimate of the speedup, not a measurement: the logratio pass is quadratic in the features, the ged methods are
+		// roughly cubic in the nodes per graph. the statistics store the speedups in percent.
+		auto pairsOf = [](std::size_t count) { return static_cast<double>(count) * static_cast<double>(count - std::min(count, static_cast<std::size_t>(1))) / 2.0; };
+		auto perGraph = [&sampleNames](std::size_t count) { return static_cast<double>(count) / static_cast<double>(std::max(sampleNames.size(), static_cast<std::size_t>(1))); };
+		double logratioSpeedup = pairsOf(featuresBefore) / std::max(pairsOf(featuresAfter), 1.0);
+		double gedSpeedup = nodesAfter == 0 ? 0 : std::pow(static_cast<double>(nodesBefore) / static_cast<double>(nodesAfter), 3);
+		newFeatureFilterStatistics = {
+				{"features_before", featuresBefore},
+				{"features_after", featuresAfter},
+				{"nodes_before", nodesBefore},
+				{"nodes_after", nodesAfter},
+				{"modeled_logratio_speedup_percent", static_cast<std::size_t>(std::llround(100 * logratioSpeedup))},
+				{"modeled_ged_speedup_percent", static_cast<std::size_t>(std::llround(100 * gedSpeedup))}
+		};
+		showInfo("Feature filter (" + featureFilter.describe() + ") kept " + std::to_string(featuresAfter) + " of " + std::to_string(featuresBefore) + " features and " + std::to_string(perGraph(nodesAfter)) + " of " + std::to_string(perGraph(nodesBefore)) + " nodes per graph on average.");
+		showInfo("Modeled speedup (not measured): " + std::to_string(logratioSpeedup) + "x for the logratio aggregates, " + std::to_string(gedSpeedup) + "x per solved pair.");
+	}
+
+	// the logratio aggregates and the relabeling costs of the dataset edit costs are quadratic in the number of features
+	std::size_t quadraticBytes = featureNames.size() * featureNames.size() * sizeof(double);
+	checkMemoryBudget("Couldn't load omics data:", getMemoryUsage().at("total") + (associatedCostsDatasetPath.empty() ? 2 : 3) * quadraticBytes,
+					  "Remove features with set_feature_filter or raise the memory budget.");
+	sampleRestorer.restore = nullptr;
+	featureFilterStatistics = std::move(newFeatureFilterStatistics);
+
 	#pragma endregion
 
 	#pragma region compute logratio aggregates
 
+	HGC_TRACE_BEGIN(logratioSpan, "logratio aggregation");
+
 	double min_logratio_{std::numeric_limits<double>::max()};
 	double max_logratio_{std::numeric_limits<double>::min()};
 	double max_feature_{std::numeric_limits<double>::min()};
@@ -304,10 +602,14 @@ void HGCGED::loadOmicsData(const std::string& omicsDatasetPath, const std::strin
 		}
 	}
 
+	HGC_TRACE_END(logratioSpan);
+
 	#pragma endregion
 
 	#pragma region construct bins
 
+	HGC_TRACE_BEGIN(binSpan, "binning");
+
 	double abundance_threshold_{0.0};
 	int number_bins_{100};
 
@@ -348,48 +650,54 @@ void HGCGED::loadOmicsData(const std::string& omicsDatasetPath, const std::strin
 			it_vec_bin->compute_mean();
 			++it_vec_bin;
 		}
-		sample_bins_.emplace_back(vec_bin);
+		sample_bins_.emplace_back(std::move(vec_bin));
 	}
 
+	HGC_TRACE_END(binSpan);
+
 	#pragma endregion
 
 	#pragma region construct sample bin pairs
 
-	ged::Matrix<std::size_t> num_samples_with_bin_pair_ = ged::Matrix<std::size_t>(number_bins_,number_bins_);
-	num_samples_with_bin_pair_.set_to_val(0);
-
-	auto it_sample_bin = sample_bins_.begin();
-	while (it_sample_bin != sample_bins_.end()) {
-		std::vector<dicoda::Bin> bins_current_sample = *it_sample_bin;
-
-		for (auto it_bin_current_sample_1 = bins_current_sample.begin() ; it_bin_current_sample_1 != bins_current_sample.end(); ++it_bin_current_sample_1) {
-			for (auto& it_bin_current_sample_2 : bins_current_sample) {
-				if (it_bin_current_sample_1->number == it_bin_current_sample_2.number) {
-					continue;
-				}
-
-				if (it_bin_current_sample_1->has_features and it_bin_current_sample_2.has_features) {
-					int i = it_bin_current_sample_1->number;
-					int j = it_bin_current_sample_2.number;
+	HGC_TRACE_BEGIN(binPairSpan, "bin pair counting");
 
-					int x = (int) num_samples_with_bin_pair_(i, j);
-					x++;
-					num_samples_with_bin_pair_(i, j) = x;
-				}
-			}
+	HGCBinPairCounts num_samples_with_bin_pair_(static_cast<std::size_t>(number_bins_), sample_bins_.size());
+	for (std::size_t sample_id{0}; sample_id < sample_bins_.size(); sample_id++) {
+		for (const dicoda::Bin& bin : sample_bins_.at(sample_id)) {
+			if (bin.has_features)
+				num_samples_with_bin_pair_.setOccupied(static_cast<std::size_t>(bin.number), sample_id);
 		}
-		++it_sample_bin;
 	}
+	num_samples_with_bin_pair_.count(numberOfWorkers);
+
+	HGC_TRACE_END(binPairSpan);
 
 	#pragma endregion
 
 	#pragma region generate graphs
 
+	HGC_TRACE_BEGIN(graphSpan, "graph generation");
+
+	std::unordered_map<std::string, std::vector<ged::GEDGraph::GraphID>> newGraphNamesToGraphIds;
 	std::size_t min_cutoff_size_{10};
 	double z_score_cutoff_{2};
 
+	// the edges of a graph are collected first, so that they can be sparsified before they are added
+	struct EdgeCandidate {
+		std::size_t nodeId1;
+		std::size_t nodeId2;
+		double label;
+		double deviation;	// distance of the edge's logratio to the mean logratio of its feature pair over all samples
+	};
+	std::size_t edgesBefore{0};
+	std::size_t edgesAfter{0};
+	std::size_t maxEdgesBefore{0};
+	std::size_t maxEdgesAfter{0};
+	std::size_t numberOfNodes{0};
+
 	for (std::size_t sample_id{0}; sample_id < sampleNames.size(); sample_id++) {
 		ged::GEDGraph::GraphID graph_id{ged->add_graph(sampleNames.at(sample_id))};
+		newGraphNamesToGraphIds[sampleNames.at(sample_id)].emplace_back(graph_id);
 		std::map<std::size_t, std::size_t> feature_ids_to_node_ids;
 		std::size_t node_id{0};
 
@@ -400,89 +708,168 @@ void HGCGED::loadOmicsData(const std::string& omicsDatasetPath, const std::strin
 			}
 		}
 
+		numberOfNodes += node_id;
+		std::vector<EdgeCandidate> edgeCandidates;
+
 		const std::vector<dicoda::Bin>& bins_current_sample = sample_bins_.at(sample_id);
 
+		// whether the logratio of the two bins deviates enough from its typical value to connect their features
+		auto binPairPasses = [&](const dicoda::Bin& bin1, const dicoda::Bin& bin2) {
+			double logratio{std::log(bin1.mean_value / bin2.mean_value)};
+			double normalized_logratio{(logratio - min_logratio_) / (max_logratio_ - min_logratio_)};
+			if (num_samples_with_bin_pair_.get(bin1.number, bin2.number) >= min_cutoff_size_) {
+				double z_score{(normalized_logratio - normalized_logratio_means_(static_cast<std::size_t>(bin1.mean_value), static_cast<std::size_t>(bin2.mean_value))) / normalized_logratio_stdevs_(static_cast<std::size_t>(bin1.mean_value), static_cast<std::size_t>(bin2.mean_value))};
+				if (std::fabs(z_score) < z_score_cutoff_)
+					return false;
+			}
+			return true;
+		};
+
+		// every unordered pair of bins is visited once. the edges are oriented like the first of the two ordered pairs that passes,
+		// which is the one gedlib kept when both orders were added.
 		for (auto it_bin_current_sample_1 = bins_current_sample.begin(); it_bin_current_sample_1 != bins_current_sample.end(); ++it_bin_current_sample_1) {
 			if (!it_bin_current_sample_1->has_features) {
 				continue;
 			}
-			for (const auto& it_bin_current_sample_2 : bins_current_sample) {
-				if (it_bin_current_sample_1->number == it_bin_current_sample_2.number) {
+			for (auto it_bin_current_sample_2 = std::next(it_bin_current_sample_1); it_bin_current_sample_2 != bins_current_sample.end(); ++it_bin_current_sample_2) {
+				if (it_bin_current_sample_1->number == it_bin_current_sample_2->number) {
 					continue;
 				}
-				if(!it_bin_current_sample_2.has_features) {
+				if(!it_bin_current_sample_2->has_features) {
 					continue;
 				}
 
-				double logratio{std::log(it_bin_current_sample_1->mean_value / it_bin_current_sample_2.mean_value)};
-				double normalized_logratio{(logratio - min_logratio_) / (max_logratio_ - min_logratio_)};
+				const dicoda::Bin* bin_1{&*it_bin_current_sample_1};
+				const dicoda::Bin* bin_2{&*it_bin_current_sample_2};
+				if (!binPairPasses(*bin_1, *bin_2)) {
+					if (!binPairPasses(*bin_2, *bin_1))
+						continue;
+					std::swap(bin_1, bin_2);
+				}
 
-				bool add_edge{true};
+				int k = 0;
+				for (auto it_bin1_features = bin_1->feature_ids.begin(); it_bin1_features != bin_1->feature_ids.end(); ++it_bin1_features) {
+					int l = 0;
+					double value_1 = bin_1->values.at(k);
+
+					for (auto it_bin2_features = bin_2->feature_ids.begin(); it_bin2_features != bin_2->feature_ids.end(); ++it_bin2_features) {
+						double value_2 = bin_2->values.at(l);
+						double logratio_exact{std::log(value_1 / value_2)};
+						double normalized_logratio_exact{(logratio_exact - min_logratio_) / (max_logratio_ - min_logratio_)};
+
+						double deviation{0};
+						if (sparsificationMode != "none") {
+							std::size_t lower_feature_id{std::min(*it_bin1_features, *it_bin2_features)};
+							std::size_t upper_feature_id{std::max(*it_bin1_features, *it_bin2_features)};
+							double mean_logratio{normalized_logratio_means_(lower_feature_id, upper_feature_id) * (max_logratio_ - min_logratio_) + min_logratio_};
+							double oriented_logratio{lower_feature_id == *it_bin1_features ? logratio_exact : -logratio_exact};
+							deviation = std::fabs(oriented_logratio - mean_logratio) / (max_logratio_ - min_logratio_);
+						}
 
-				if (num_samples_with_bin_pair_(it_bin_current_sample_1->number,it_bin_current_sample_2.number)>=min_cutoff_size_) {
-					double z_score{(normalized_logratio - normalized_logratio_means_(static_cast<std::size_t>(it_bin_current_sample_1->mean_value), static_cast<std::size_t>(it_bin_current_sample_2.mean_value))) / normalized_logratio_stdevs_(static_cast<std::size_t>(it_bin_current_sample_1->mean_value), static_cast<std::size_t>(it_bin_current_sample_2.mean_value))};
-					if (std::fabs(z_score) < z_score_cutoff_) {
-						add_edge = false;
+						edgeCandidates.push_back({feature_ids_to_node_ids.at(*it_bin1_features), feature_ids_to_node_ids.at(*it_bin2_features), normalized_logratio_exact, deviation});
+						l++;
 					}
+					k++;
 				}
+			}
+		}
 
-				if (add_edge) {
-
-					int k = 0;
-					for (auto it_bin1_features = it_bin_current_sample_1->feature_ids.begin(); it_bin1_features != it_bin_current_sample_1->feature_ids.end(); ++it_bin1_features) {
-						int l = 0;
-						double value_1 = it_bin_current_sample_1->values.at(k);
-
-						for (auto it_bin2_features = it_bin_current_sample_2.feature_ids.begin(); it_bin2_features != it_bin_current_sample_2.feature_ids.end(); ++it_bin2_features) {
-							double value_2 = it_bin_current_sample_2.values.at(l);
-							double logratio_exact{std::log(value_1 / value_2)};
-							double normalized_logratio_exact{(logratio_exact - min_logratio_) / (max_logratio_ - min_logratio_)};
+		// keep the edges which deviate most from the typical logratio of their feature pair
+		std::vector<bool> keepEdge(edgeCandidates.size(), sparsificationMode == "none");
+		auto moreDeviating = [&edgeCandidates](std::size_t a, std::size_t b) { return edgeCandidates.at(a).deviation > edgeCandidates.at(b).deviation; };
+		if (sparsificationMode == "top_k") {
+			// an edge is kept if it is among the k most deviating edges of at least one of its nodes
+			std::vector<std::vector<std::size_t>> incidentEdges(node_id);
+			for (std::size_t edgeId = 0; edgeId < edgeCandidates.size(); edgeId++) {
+				incidentEdges.at(edgeCandidates.at(edgeId).nodeId1).emplace_back(edgeId);
+				incidentEdges.at(edgeCandidates.at(edgeId).nodeId2).emplace_back(edgeId);
+			}
+			for (std::vector<std::size_t>& edgeIds : incidentEdges) {
+				std::size_t keep = std::min(sparsificationValue, edgeIds.size());
+				std::partial_sort(edgeIds.begin(), edgeIds.begin() + static_cast<long>(keep), edgeIds.end(), moreDeviating);
+				for (std::size_t index = 0; index < keep; index++)
+					keepEdge.at(edgeIds.at(index)) = true;
+			}
+		}
+		else if (sparsificationMode == "budget") {
+			std::vector<std::size_t> edgeIds(edgeCandidates.size());
+			std::iota(edgeIds.begin(), edgeIds.end(), 0);
+			std::size_t keep = std::min(sparsificationValue, edgeIds.size());
+			std::nth_element(edgeIds.begin(), edgeIds.begin() + static_cast<long>(keep), edgeIds.end(), moreDeviating);
+			for (std::size_t index = 0; index < keep; index++)
+				keepEdge.at(edgeIds.at(index)) = true;
+		}
 
-							ged->add_edge(graph_id, feature_ids_to_node_ids.at(*it_bin1_features), feature_ids_to_node_ids.at(*it_bin2_features), normalized_logratio_exact);
-							l++;
-						}
-						k++;
-					}
-				}
+		std::size_t edges{0};
+		for (std::size_t edgeId = 0; edgeId < edgeCandidates.size(); edgeId++) {
+			if (keepEdge.at(edgeId)) {
+				ged->add_edge(graph_id, edgeCandidates.at(edgeId).nodeId1, edgeCandidates.at(edgeId).nodeId2, static_cast<HGCEdgeLabel>(edgeCandidates.at(edgeId).label));
+				edges++;
 			}
 		}
+		edgesBefore += edgeCandidates.size();
+		edgesAfter += edges;
+		maxEdgesBefore = std::max(maxEdgesBefore, edgeCandidates.size());
+		maxEdgesAfter = std::max(maxEdgesAfter, edges);
+	}
+
+	sparsificationStatistics = {
+			{"graphs", sampleNames.size()},
+			{"nodes", numberOfNodes},
+			{"edges_before", edgesBefore},
+			{"edges_after", edgesAfter},
+			{"max_edges_before", maxEdgesBefore},
+			{"max_edges_after", maxEdgesAfter}
+	};
+	if (sparsificationMode != "none" && !sampleNames.empty()) {
+		auto perGraph = [&sampleNames](std::size_t count) { return std::to_string(static_cast<double>(count) / static_cast<double>(sampleNames.size())); };
+		showInfo("Sparsification (" + sparsificationMode + " " + std::to_string(sparsificationValue) + ") kept " + std::to_string(edgesAfter) + " of " + std::to_string(edgesBefore) + " edges: " + perGraph(edgesBefore) + " -> " + perGraph(edgesAfter) + " edges per graph on average, " + std::to_string(maxEdgesBefore) + " -> " + std::to_string(maxEdgesAfter) + " at most, with " + perGraph(numberOfNodes) + " nodes per graph on average.");
 	}
 
+	HGC_TRACE_END(graphSpan);
+
+	std::size_t newStoredNodes = numberOfNodes;
+	std::size_t newStoredEdges = edgesAfter;
+
 	#pragma endregion
 
 	#pragma endregion
 
 	#pragma region copy non sample graphs into new ged environment
 
+	HGC_TRACE_BEGIN(copySpan, "copy non sample graphs");
+
 	// copy non-sample graphs from old ged into new ged
 	for (std::size_t nonSampleGraphId = firstNonSampleGraphId; nonSampleGraphId < ged_->num_graphs(); nonSampleGraphId++) {
 		std::string nonSampleGraphName = ged_->get_graph_name(nonSampleGraphId);
 
 		// if attributes are loaded, check if the graph name is already used
-		if (!sampleNamesToAttributes.empty()) {
-			for (std::size_t sampleGraphId = 0; sampleGraphId < ged->num_graphs(); sampleGraphId++) {
-				const std::string& sampleGraphName = ged->get_graph_name(sampleGraphId);
-				if (nonSampleGraphName == sampleGraphName) {
-					showWarning("Adding the sample with name \"" + sampleGraphName + "\" will result in the HGC Environment containing mutiple graphs with that name afterwards. This might lead to unwanted behavior when associating attribute data to graphs.");
-				}
-			}
+		if (!attributes.empty() && newGraphNamesToGraphIds.find(nonSampleGraphName) != newGraphNamesToGraphIds.end()) {
+			showWarning("Adding the sample with name \"" + nonSampleGraphName + "\" will result in the HGC Environment containing mutiple graphs with that name afterwards. This might lead to unwanted behavior when associating attribute data to graphs.");
 		}
 
 		// copy graph
-		ged::ExchangeGraph<std::size_t, std::size_t, double> graph = ged_->get_graph(nonSampleGraphId, false, false, true);
+		ged::ExchangeGraph<HGCNodeId, HGCNodeLabel, HGCEdgeLabel> graph = ged_->get_graph(nonSampleGraphId, false, false, true);
 		ged::GEDGraph::GraphID graphId = ged->add_graph(nonSampleGraphName);
+		newGraphNamesToGraphIds[nonSampleGraphName].emplace_back(graphId);
 		for (std::size_t nodeId : graph.original_node_ids) {
 			ged->add_node(graphId, nodeId, graph.node_labels.at(nodeId));
 		}
-		for (std::pair<std::pair<std::size_t, std::size_t>, double> edge : graph.edge_list) {
+		for (const std::pair<std::pair<std::size_t, std::size_t>, HGCEdgeLabel>& edge : graph.edge_list) {
 			ged->add_edge(graphId, edge.first.first, edge.first.second, edge.second);
 		}
+		newStoredNodes += graph.original_node_ids.size();
+		newStoredEdges += graph.edge_list.size();
 	}
 
+	HGC_TRACE_END(copySpan);
+
 	#pragma endregion
 
 	#pragma region deal with edit costs
 
+	HGC_TRACE_BEGIN(costsSpan, "edit costs");
+
 	if (!associatedCostsDatasetPath.empty()) {
 		delete(datasetEditCosts);
 
@@ -507,7 +894,8 @@ void HGCGED::loadOmicsData(const std::string& omicsDatasetPath, const std::strin
 				featureIdRowIndex = featureNamesToFeatureIds.at(featureNameRowIndex);
 			}
 			catch (std::out_of_range& error) {
-				showWarning("Feature \"" + featureNameRowIndex + "\" is not part of the omics data. Its costs data will be ignored.");
+				if (filteredFeatureNames.find(featureNameRowIndex) == filteredFeatureNames.end())
+					showWarning("Feature \"" + featureNameRowIndex + "\" is not part of the omics data. Its costs data will be ignored.");
 				continue;
 			}
 
@@ -548,7 +936,7 @@ void HGCGED::loadOmicsData(const std::string& omicsDatasetPath, const std::strin
 		// set edit costs
 		editCostsName = "dataset";
 
-		datasetEditCosts = new HGCCosts<std::size_t, double>(nodeRelabelingCosts);
+		datasetEditCosts = new HGCCosts<HGCNodeLabel, HGCEdgeLabel>(nodeRelabelingCosts, costNodeFactor, costInsertDeleteFactor);
 	}
 	else {
 		if (customEditCosts) {
@@ -559,10 +947,14 @@ void HGCGED::loadOmicsData(const std::string& omicsDatasetPath, const std::strin
 		}
 	}
 
+	HGC_TRACE_END(costsSpan);
+
 	#pragma endregion
 
 	#pragma region initialize new ged environment
 
+	HGC_TRACE_BEGIN(initSpan, "initialize environment");
+
 	if (editCostsName == "dataset") {
 		ged->set_edit_costs(datasetEditCosts);
 	}
@@ -573,11 +965,18 @@ void HGCGED::loadOmicsData(const std::string& omicsDatasetPath, const std::strin
 		ged->set_edit_costs(ged::Options::EditCosts::CONSTANT);
 	}
 	ged->set_method(loadMethod(methodName));
-	ged->init(ged_->get_init_type());
-	ged->init_method();
 
 	delete(ged_);
-	ged_ = ged;
+	ged_ = ged.release();
+	snapshots.clear();
+	snapshotArenas.clear();
+	modifiedGraphs.clear();
+	graphNamesToGraphIds = std::move(newGraphNamesToGraphIds);
+	labelsOutdated = true;
+	storedNodes = newStoredNodes;
+	storedEdges = newStoredEdges;
+
+	HGC_TRACE_END(initSpan);
 
 	#pragma endregion
 
@@ -599,22 +998,37 @@ void HGCGED::loadAttributesData(const std::string& attributesDatasetPath, char s
 		throwError("Couldn't load attributes data:", "Duplicate sample names in \"" + attributesDatasetPath + "\".");
 	}
 
-	// add the attributes to the current attributes data
+	// add the samples and columns to the current attributes data
+	std::vector<std::size_t> sampleIds;
 	for (std::size_t rowIndex = 1; rowIndex < csvParser.num_rows(); rowIndex++) {
 		const std::string& sampleName = csvParser.cell(rowIndex, 0);
-		if (sampleNamesToAttributes.find(sampleName) != sampleNamesToAttributes.end()) {
+		if (attributes.hasSample(sampleName)) {
 			showWarning("HGC Environment already contains attributes data for a sample with name \"" + sampleName + "\". They will be overwritten.");
-			sampleNamesToAttributes.erase(sampleName);
-		}
-
-		std::map<std::string, std::string> attributeNamesToAttributeValues;
-		for (std::size_t columnIndex = 1; columnIndex < csvParser.num_columns(); columnIndex++) {
-			const std::string& attributeName = csvParser.cell(0, columnIndex);
-			const std::string& attributeValue = csvParser.cell(rowIndex, columnIndex);
-			attributeNamesToAttributeValues.emplace(attributeName, attributeValue);
 		}
-		sampleNamesToAttributes.emplace(sampleName, attributeNamesToAttributeValues);
+		sampleIds.emplace_back(attributes.addSample(sampleName));
+	}
+	std::vector<std::size_t> columnIds;
+	for (std::size_t columnIndex = 1; columnIndex < csvParser.num_columns(); columnIndex++) {
+		columnIds.emplace_back(attributes.addColumn(csvParser.cell(0, columnIndex)));
 	}
+	attributes.resizeColumns();
+
+	// dictionary encode the columns in parallel, each column is encoded by a single worker
+	std::atomic<std::size_t> nextColumn{0};
+	auto encodeColumns = [this, &csvParser, &sampleIds, &columnIds, &nextColumn]() {
+		for (std::size_t column = nextColumn++; column < columnIds.size(); column = nextColumn++) {
+			for (std::size_t row = 0; row < sampleIds.size(); row++)
+				attributes.set(columnIds.at(column), sampleIds.at(row), csvParser.cell(row + 1, column + 1));
+		}
+	};
+	std::vector<std::thread> workers;
+	for (std::size_t worker = 1; worker < std::min(numberOfWorkers, columnIds.size()); worker++)
+		workers.emplace_back(encodeColumns);
+	encodeColumns();
+	for (std::thread& worker : workers)
+		worker.join();
+
+	labelsOutdated = true;
 
 }
 
@@ -627,6 +1041,14 @@ void HGCGED::generateLabels(const std::string& labeledAttribute = "") {
 	if (!ged_)
 		throwError("Couldn't generate graph labels:", "HGC environment not constructed.");
 
+	// the labels only change with the graphs or the attributes
+	if (!labelsOutdated && labeledAttribute == labelAttribute && labelVector.size() == ged_->num_graphs())
+		return;
+	labelsOutdated = false;
+	labelAttribute = labeledAttribute;
+	labelCodes.clear();
+	labelDictionary.clear();
+
 	// reset vector
 	labelVector = std::vector<std::string>(ged_->num_graphs(), "");
 
@@ -636,71 +1058,578 @@ void HGCGED::generateLabels(const std::string& labeledAttribute = "") {
 			labelVector.at(graphId) = std::to_string(graphId) + "_" + ged_->get_graph_name(graphId);
 	}
 	else {
+		// gather the codes of the labeled attribute for all graphs at once
+		std::size_t column = attributes.findColumn(labeledAttribute);
+		std::vector<std::size_t> sampleIds(ged_->num_graphs());
+		for (std::size_t graphId = 0; graphId < ged_->num_graphs(); graphId++)
+			sampleIds.at(graphId) = attributes.findSample(ged_->get_graph_name(graphId));
+		labelCodes = column == HGCAttributeTable::notFound ? std::vector<std::uint32_t>(ged_->num_graphs(), HGCAttributeTable::missing) : attributes.gather(column, sampleIds);
+
 		for (std::size_t graphId = 0; graphId < ged_->num_graphs(); graphId++) {
 			std::string graphName = ged_->get_graph_name(graphId);
 
 			// use name as label if the environment doesn't contain attributes for this graph
-			if (sampleNamesToAttributes.find(graphName) == sampleNamesToAttributes.end()) {
+			if (sampleIds.at(graphId) == HGCAttributeTable::notFound) {
 				if (isSampleGraph(graphId)) {
 					showWarning("The graph of sample \"" + graphName + "\" has no associated attributes. Using it's name as it's label instead.");
 				}
 				labelVector.at(graphId) = std::to_string(graphId) + "_" + graphName;
 			}
+				// use name as label if the graph doesn't contain the graph attribute
+			else if (labelCodes.at(graphId) == HGCAttributeTable::missing) {
+				showWarning("The attributes of graph \"" + graphName + "\" do not contain \"" + labeledAttribute + "\". Using it's name as it's label instead."); // NOLINT(performance-inefficient-string-concatenation)
+				labelVector.at(graphId) = std::to_string(graphId) + "_" + graphName;
+			}
+				// use attribute as label
 			else {
-				std::map<std::string, std::string> attributeNamesToAttributeValues = sampleNamesToAttributes.at(graphName);
+				labelVector.at(graphId) = std::to_string(graphId) + "_" + attributes.getDictionary(column).at(labelCodes.at(graphId));
+			}
+		}
+		labelDictionary = column == HGCAttributeTable::notFound ? std::vector<std::string>() : attributes.getDictionary(column);
+	}
 
-				// use name as label if the graph doesn't contain the graph attribute
-				if (attributeNamesToAttributeValues.find(labeledAttribute) == attributeNamesToAttributeValues.end()) {
-					showWarning("The attributes of graph \"" + graphName + "\" do not contain \"" + labeledAttribute + "\". Using it's name as it's label instead."); // NOLINT(performance-inefficient-string-concatenation)
-					labelVector.at(graphId) = std::to_string(graphId) + "_" + graphName;
-				}
-					// use attribute as label
-				else {
-					labelVector.at(graphId) = std::to_string(graphId) + "_" + attributeNamesToAttributeValues.at(labeledAttribute);
-				}
+}
+
+// hashes everything the results of a computation depend on, so that checkpoints of another environment are not resumed
+std::uint64_t HGCGED::computeFingerprint() {
+	std::uint64_t fingerprint = HGCCheckpoint::hash(methodName.data(), methodName.size());
+	std::string arguments = solverArguments();
+	fingerprint = HGCCheckpoint::hash(arguments.data(), arguments.size(), fingerprint);
+	fingerprint = HGCCheckpoint::hash(editCostsName.data(), editCostsName.size(), fingerprint);
+	if (editCostsName == "dataset") {
+		double factors[2] = {costNodeFactor, costInsertDeleteFactor};
+		fingerprint = HGCCheckpoint::hash(factors, sizeof(factors), fingerprint);
+	}
+
+	for (std::size_t graphId = 0; graphId < snapshots.size(); graphId++) {
+		std::string graphName = ged_->get_graph_name(graphId);
+		const HGCGraphSnapshot<HGCNodeLabel, HGCEdgeLabel>& snapshot = snapshots.at(graphId);
+		fingerprint = HGCCheckpoint::hash(graphName.data(), graphName.size(), fingerprint);
+		fingerprint = HGCCheckpoint::hash(snapshot.nodeLabels.data(), snapshot.nodeLabels.size() * sizeof(HGCNodeLabel), fingerprint);
+		fingerprint = HGCCheckpoint::hash(snapshot.edgeOffsets.data(), snapshot.edgeOffsets.size() * sizeof(std::uint32_t), fingerprint);
+		fingerprint = HGCCheckpoint::hash(snapshot.edgeTargets.data(), snapshot.edgeTargets.size() * sizeof(std::uint32_t), fingerprint);
+		fingerprint = HGCCheckpoint::hash(snapshot.edgeLabels.data(), snapshot.edgeLabels.size() * sizeof(HGCEdgeLabel), fingerprint);
+	}
+
+	return fingerprint;
+}
+
+// returns the method arguments of the single-threaded solver contexts, including the pair budget, which replaces the limits given in
+// the method arguments. only BRANCH_TIGHT iterates and can be stopped early, the other methods solve a single assignment problem per pair.
+std::string HGCGED::solverArguments() {
+	std::string arguments = removeMethodThread(methodArguments);
+	if (hasPairBudget()) {
+		if (pairTimeLimit > 0) {
+			arguments = removeMethodArgument(arguments, "--time-limit");
+			arguments += (arguments.empty() ? "" : " ") + std::string("--time-limit ") + std::to_string(pairTimeLimit);
+		}
+		if (pairIterationLimit > 0) {
+			arguments = removeMethodArgument(arguments, "--iterations");
+			arguments += (arguments.empty() ? "" : " ") + std::string("--iterations ") + std::to_string(pairIterationLimit);
+		}
+	}
+	return arguments;
+}
+
+// checks if the pairs are solved within a budget, which is only the case for BRANCH_TIGHT
+bool HGCGED::hasPairBudget() {
+	return methodName == "BRANCH_TIGHT" && (pairTimeLimit > 0 || pairIterationLimit > 0);
+}
+
+// updates the graph snapshots, so that the workers can read the graphs without touching the ged environment, and sets up one solver
+// context with the given number of slots per worker. the workers solve whole pairs in parallel, so each solver runs single-threaded.
+void HGCGED::prepareSolvers(std::size_t numberOfSlots) {
+	HGC_TRACE_SCOPE("prepare solvers");
+	updateGraphSnapshots();
+
+	graphFeatures.clear();
+	for (const HGCGraphSnapshot<HGCNodeLabel, HGCEdgeLabel>& snapshot : snapshots)
+		graphFeatures.emplace_back(HGCCostModel::graphFeatures(snapshot.degrees(), snapshot.numberOfEdges()));
+
+	std::size_t workers = std::max(std::min(numberOfWorkers, snapshots.size()), static_cast<std::size_t>(1));
+	ged::Options::GEDMethod method = loadMethod(methodName);
+	std::string contextArguments = solverArguments();
+	contexts.clear();
+	for (std::size_t worker = 0; worker < workers; worker++)
+		contexts.emplace_back(std::make_unique<HGCSolverContext<HGCNodeLabel, HGCEdgeLabel>>(getEditCosts(), method, contextArguments, numberOfSlots));
+
+	// without the GIL held by the computing thread, the custom edit costs are evaluated by a single dispatch thread instead of
+	// every solver thread acquiring the GIL per call
+	if (customEditCosts && customEditCosts->multiThreaded && dispatchCustomCosts)
+		customEditCosts->startDispatcher(std::size_t{1} << 18);
+}
+
+// releases the solver contexts. the graph snapshots are kept for the next computation.
+void HGCGED::releaseSolvers() {
+	graphFeatures.clear();
+	contexts.clear();
+	std::size_t numberOfPythonCalls = customEditCosts ? customEditCosts->stopDispatcher() : 0;
+	if (numberOfPythonCalls > 0)
+		showInfo("Custom edit costs were evaluated " + std::to_string(numberOfPythonCalls) + " times in python.");
+}
+
+// solves the given list of pairs in parallel using the solver contexts set up by prepareSolvers and returns their upper bounds. if
+// lowerBounds is passed, it receives the lower bounds of the pairs. if inspect is passed, the worker calls it with the index of every
+// solved pair and its solver context, e.g. to read the node map.
+std::vector<double> HGCGED::solvePairs(const std::vector<std::pair<std::size_t, std::size_t>>& pairs, std::vector<double>* lowerBounds,
+									   const std::function<void(std::size_t, const HGCSolverContext<HGCNodeLabel, HGCEdgeLabel>&)>& inspect) {
+	std::vector<double> results(pairs.size(), 0);
+	if (lowerBounds)
+		lowerBounds->assign(pairs.size(), 0);
+	std::atomic<std::size_t> nextPair{0};
+
+	// longest job first, so that no worker is left with a large pair at the end
+	std::vector<double> predictedSeconds(pairs.size());
+	for (std::size_t index = 0; index < pairs.size(); index++)
+		predictedSeconds.at(index) = costModel.predict(methodName, graphFeatures.at(pairs.at(index).first), graphFeatures.at(pairs.at(index).second));
+	std::vector<std::size_t> order(pairs.size());
+	std::iota(order.begin(), order.end(), 0);
+	std::stable_sort(order.begin(), order.end(), [&predictedSeconds](std::size_t a, std::size_t b) { return predictedSeconds.at(a) > predictedSeconds.at(b); });
+
+	auto solve = [this, &pairs, &results, lowerBounds, &inspect, &nextPair, &order](HGCSolverContext<HGCNodeLabel, HGCEdgeLabel>& context) {
+		for (std::size_t position = nextPair++; position < pairs.size(); position = nextPair++) {
+			std::size_t index = order.at(position);
+			std::size_t graphId1 = pairs.at(index).first;
+			std::size_t graphId2 = pairs.at(index).second;
+			if (graphId1 != graphId2) {
+				results.at(index) = context.run(graphId1, snapshots.at(graphId1), graphId2, snapshots.at(graphId2));
+				if (lowerBounds)
+					lowerBounds->at(index) = context.getLowerBound();
+				if (inspect)
+					inspect(index, context);
 			}
 		}
+	};
+
+	if (contexts.size() == 1) {
+		solve(*contexts.front());
+		return results;
+	}
+
+	std::vector<std::exception_ptr> errors(contexts.size());
+	std::vector<std::thread> threads;
+	for (std::size_t worker = 0; worker < contexts.size(); worker++) {
+		threads.emplace_back([this, worker, &solve, &pairs, &nextPair, &errors]() {
+			try {
+				solve(*contexts.at(worker));
+			}
+			catch (...) {
+				errors.at(worker) = std::current_exception();
+				nextPair = pairs.size();
+			}
+		});
+	}
+	for (std::thread& thread : threads)
+		thread.join();
+	for (const std::exception_ptr& error : errors) {
+		if (error)
+			std::rethrow_exception(error);
 	}
 
+	return results;
 }
 
-// the actual implementation of the method that computes the ged matrix
-void HGCGED::computeGedsGilScope() {
+// sets up the results, the graph snapshots, the solver contexts and, if a path is passed, the checkpoint of a computation
+void HGCGED::beginCompute(const std::string& checkpointPath, std::size_t checkpointIntervalSeconds) {
 
 	// security
 	if (!ged_)
 		throwError("Couldn't compute graph edit distances:", "HGC environment not constructed.");
+	if (computeRunning)
+		throwError("Couldn't compute graph edit distances:", "Another computation is still running.");
+
+	// fail before allocating the results if they exceed the memory budget, dropping the node maps first if that is enough
+	std::size_t numberOfGraphs = ged_->num_graphs();
+	if (memoryBudget > 0) {
+		updateGraphSnapshots();
+		std::map<std::string, std::size_t> usage = getMemoryUsage();
+		std::size_t maximumNodes = 0;
+		for (const HGCGraphSnapshot<HGCNodeLabel, HGCEdgeLabel>& snapshot : snapshots)
+			maximumNodes = std::max(maximumNodes, snapshot.numberOfNodes());
+
+		std::size_t retainedBytes = usage.at("total") - usage.at("distance_matrix") - usage.at("node_maps") - usage.at("gap_matrix") - usage.at("solver_contexts");
+		std::size_t resultBytes = numberOfGraphs * (sizeof(std::vector<int>) + numberOfGraphs * sizeof(int)) + (hasPairBudget() ? numberOfGraphs * numberOfGraphs * sizeof(double) : 0);
+		std::size_t solverBytes = std::max(std::min(numberOfWorkers, numberOfGraphs), static_cast<std::size_t>(1)) * pairStateBytes(maximumNodes, tileSlots);
+		std::size_t nodeMapBytes = numberOfGraphs * (sizeof(std::vector<int>) + storedNodes * sizeof(int));
+		bool keepNodeMaps = !distancesOnly;
+		if (keepNodeMaps && retainedBytes + resultBytes + solverBytes + nodeMapBytes > memoryBudget && retainedBytes + resultBytes + solverBytes <= memoryBudget) {
+			showWarning("Keeping the node maps would need " + toMebibytes(nodeMapBytes) + " and exceed the memory budget of " + toMebibytes(memoryBudget) + ". Switching to distances only mode for this computation.");
+			keepNodeMaps = false;
+		}
+		checkMemoryBudget("Couldn't compute graph edit distances:", retainedBytes + resultBytes + solverBytes + (keepNodeMaps ? nodeMapBytes : 0),
+						  "Use compute_geds_mapped to stream the matrix into a file, compute_single_linkage to cluster without the matrix, or raise the memory budget.");
 
-	// setup results
-	distanceMatrix = std::vector<std::vector<int>>(ged_->num_graphs(), std::vector<int>(ged_->num_graphs(), -1));
+		// the switch only applies to this computation, finishCompute restores the mode
+		if (!keepNodeMaps && !distancesOnly) {
+			requestedDistancesOnly = distancesOnly;
+			distancesOnly = true;
+		}
+	}
 
-	// setup console output
-	std::cout << std::fixed << std::setprecision(2) << std::endl;
-	float scaler;
-	if (ged_->num_graphs() == 0) {
-		std::cout << "\033[A\33[KEnvironment is empty. Nothing to compute." << std::endl;
+	// setup results. in distances only mode the node maps are discarded right after the distances are extracted.
+	distanceMatrix = std::vector<std::vector<int>>(numberOfGraphs, std::vector<int>(numberOfGraphs, -1));
+	nodeMaps = std::vector<std::vector<int>>(distancesOnly ? 0 : numberOfGraphs);
+	gapMatrix = std::vector<std::vector<double>>(hasPairBudget() ? numberOfGraphs : 0, std::vector<double>(numberOfGraphs, 0));
+	budgetExceededPairs.clear();
+	completedRows = std::make_unique<std::atomic<bool>[]>(numberOfGraphs);
+	for (std::size_t row = 0; row < numberOfGraphs; row++)
+		completedRows[row] = false;
+	nextRow = 0;
+	computedPairs = 0;
+	cancelRequested = false;
+	computeError = nullptr;
+	peakResettable = resetPeakResidentSetSize();
+
+	prepareSolvers(tileSlots);
+
+	// restore the rows which were completed by a previous run. the solvers are released again if the checkpoint can't be opened.
+	checkpoint.reset();
+	try {
+		if (!checkpointPath.empty()) {
+			checkpoint = std::make_unique<HGCCheckpoint>(checkpointPath, numberOfGraphs, computeFingerprint());
+			checkpointedRows = std::vector<bool>(numberOfGraphs, false);
+			checkpointInterval = std::chrono::seconds(checkpointIntervalSeconds);
+			lastCheckpoint = std::chrono::steady_clock::now();
+
+			std::vector<std::size_t> restoredRows = checkpoint->load(distanceMatrix);
+			for (std::size_t row : restoredRows) {
+				completedRows[row] = true;
+				checkpointedRows.at(row) = true;
+			}
+			computedPairs = restoredRows.size() * numberOfGraphs;
+			if (!restoredRows.empty())
+				showInfo("Resuming from checkpoint \"" + checkpointPath + "\" with " + std::to_string(restoredRows.size()) + " of " + std::to_string(numberOfGraphs) + " rows completed.");
+		}
+
+		groupIdenticalGraphs();
+		scheduleRows();
+	}
+	catch (...) {
+		releaseSolvers();
+		checkpoint.reset();
+		restoreDistancesOnly();
+		throw;
+	}
+	computeRunning = true;
+}
+
+// restores the distances only mode which beginCompute switched on for a computation that couldn't keep the node maps
+void HGCGED::restoreDistancesOnly() {
+	if (requestedDistancesOnly) {
+		distancesOnly = *requestedDistancesOnly;
+		requestedDistancesOnly.reset();
+	}
+}
+
+// orders the rows longest job first by their predicted runtime, so that the workers do not idle at the end waiting for a single large row
+void HGCGED::scheduleRows() {
+	std::vector<double> predictedSeconds(representatives.size(), 0);
+	for (std::size_t classId1 = 0; classId1 < representatives.size(); classId1++) {
+		for (std::size_t classId2 = 0; classId2 < representatives.size(); classId2++) {
+			if (classId1 != classId2)
+				predictedSeconds.at(classId1) += costModel.predict(methodName, graphFeatures.at(representatives.at(classId1)), graphFeatures.at(representatives.at(classId2)));
+		}
+	}
+
+	rowOrder = std::vector<std::size_t>(representatives.size());
+	std::iota(rowOrder.begin(), rowOrder.end(), 0);
+	std::stable_sort(rowOrder.begin(), rowOrder.end(), [&predictedSeconds](std::size_t a, std::size_t b) { return predictedSeconds.at(a) > predictedSeconds.at(b); });
+
+	// every worker keeps a sample of at most maximumSamples / workers measured pairs to calibrate the cost model with
+	std::size_t maximumSamples = 100000;
+	sampleStride = std::max(representatives.size() * representatives.size() / maximumSamples, static_cast<std::size_t>(1));
+	workerSamples = std::vector<std::vector<HGCCostModel::Sample>>(contexts.size());
+	workerBudgetExceededPairs = std::vector<std::vector<std::pair<std::size_t, std::size_t>>>(contexts.size());
+}
+
+// compares the predicted with the measured runtimes of the sampled pairs, writes them into the schedule log and recalibrates the cost model
+void HGCGED::calibrateCostModel() {
+	std::vector<HGCCostModel::Sample> samples;
+	for (const std::vector<HGCCostModel::Sample>& worker : workerSamples)
+		samples.insert(samples.end(), worker.begin(), worker.end());
+	workerSamples.clear();
+	if (samples.empty())
 		return;
+
+	double predictedSeconds = 0;
+	double actualSeconds = 0;
+	double absoluteError = 0;
+	for (const HGCCostModel::Sample& sample : samples) {
+		predictedSeconds += sample.predictedSeconds;
+		actualSeconds += sample.actualSeconds;
+		absoluteError += std::fabs(sample.predictedSeconds - sample.actualSeconds);
 	}
-	else
-		scaler = 100.0f / static_cast<float>(ged_->num_graphs() * ged_->num_graphs());
+	showInfo("Cost model predicted " + std::to_string(predictedSeconds) + " s for " + std::to_string(samples.size()) + " sampled pairs which took " + std::to_string(actualSeconds) + " s (mean absolute error " + std::to_string(absoluteError / static_cast<double>(samples.size())) + " s per pair).");
 
-	// run method & save results
-	std::size_t c = 0;
-	for (std::size_t graphId1 = 0; graphId1 < ged_->num_graphs(); graphId1++) {
+	if (!scheduleLogPath.empty())
+		HGCCostModel::writeLog(scheduleLogPath, samples);
+	costModel.calibrate(methodName, samples);
+}
 
-		for (std::size_t graphId2 = 0; graphId2 < ged_->num_graphs(); graphId2++) {
+// groups the graphs into classes of identical graphs, so that only one row and column per class has to be solved. graphs whose node
+// labels are not unique are never grouped, as their canonical hash does not identify them up to isomorphism. node maps are only valid for
+// the pair they were computed for, so nothing is grouped if they are kept.
+void HGCGED::groupIdenticalGraphs() {
+	representatives.clear();
+	classMembers.clear();
+
+	std::unordered_map<std::uint64_t, std::vector<std::size_t>> classesByHash;
+	for (std::size_t graphId = 0; graphId < snapshots.size(); graphId++) {
+		const HGCGraphSnapshot<HGCNodeLabel, HGCEdgeLabel>& snapshot = snapshots.at(graphId);
+
+		if (deduplicate && distancesOnly && snapshot.hasUniqueNodeLabels) {
+			std::vector<std::size_t>& candidates = classesByHash[snapshot.canonicalHash];
+			auto identicalClass = std::find_if(candidates.begin(), candidates.end(), [this, &snapshot](std::size_t classId) {
+				return snapshots.at(representatives.at(classId)).isIdentical(snapshot);
+			});
+			if (identicalClass != candidates.end()) {
+				classMembers.at(*identicalClass).emplace_back(graphId);
+				continue;
+			}
+			candidates.emplace_back(representatives.size());
+		}
 
-			if (graphId1 == graphId2)
-				distanceMatrix.at(graphId1).at(graphId2) = 0;
-			else {
-				ged_->run_method(graphId1, graphId2);
-				distanceMatrix.at(graphId1).at(graphId2) = static_cast<int>(ged_->get_upper_bound(graphId1, graphId2));
+		representatives.emplace_back(graphId);
+		classMembers.emplace_back(std::vector<std::size_t>{graphId});
+	}
+
+	std::size_t largestClass = 0;
+	for (const std::vector<std::size_t>& members : classMembers)
+		largestClass = std::max(largestClass, members.size());
+	deduplicationStatistics = {
+			{"graphs", snapshots.size()},
+			{"classes", representatives.size()},
+			{"largest_class", largestClass},
+			{"solved_pairs", representatives.size() * (representatives.size() - std::min(representatives.size(), static_cast<std::size_t>(1)))},
+			{"skipped_pairs", snapshots.size() * snapshots.size() - representatives.size() * representatives.size()}
+	};
+	if (representatives.size() < snapshots.size())
+		showInfo("Found " + std::to_string(representatives.size()) + " unique graphs among " + std::to_string(snapshots.size()) + " graphs (largest class: " + std::to_string(largestClass) + "). Skipping " + std::to_string(deduplicationStatistics.at("skipped_pairs")) + " pairs.");
+}
+
+// copies the completed row of the representative of the given class to all other members of the class
+void HGCGED::fanOutRow(std::size_t classId) {
+	std::size_t representative = representatives.at(classId);
+	for (std::size_t member : classMembers.at(classId)) {
+		if (member == representative || completedRows[member])
+			continue;
+		distanceMatrix.at(member) = distanceMatrix.at(representative);
+		if (!gapMatrix.empty())
+			gapMatrix.at(member) = gapMatrix.at(representative);
+		completedRows[member].store(true, std::memory_order_release);
+		computedPairs += snapshots.size();
+	}
+	completedRows[representative].store(true, std::memory_order_release);
+}
+
+// solves whole rows of the ged matrix with the given solver context until no rows are left or the computation is cancelled. a worker
+// takes a few rows at once and solves them against blocks of columns, loading the graphs of each tile into its solver context once,
+// so that a graph is reloaded once per tile instead of once per pair. the coordinating worker additionally reports the progress and
+// writes the checkpoints.
+void HGCGED::computeRows(std::size_t worker, bool coordinating) {
+	float scaler = 100.0f / static_cast<float>(snapshots.size() * snapshots.size());
+	HGCSolverContext<HGCNodeLabel, HGCEdgeLabel>& context = *contexts.at(worker);
+	std::vector<HGCCostModel::Sample>& samples = workerSamples.at(worker);
+	std::vector<std::pair<std::size_t, std::size_t>>& exceededPairs = workerBudgetExceededPairs.at(worker);
+	bool budgeted = !gapMatrix.empty();
+	std::size_t solvedPairs = 0;
+
+	// fewer rows per task once there are few rows per worker, so that the workers finish together
+	std::size_t rowsPerTask = std::max(std::min(tileRows, rowOrder.size() / (4 * contexts.size())), static_cast<std::size_t>(1));
+	std::size_t columnsPerTile = std::max(context.numberOfSlots() - rowsPerTask, static_cast<std::size_t>(1));
+
+	// only the representatives of the classes of identical graphs are solved, their results are fanned out to all members
+	for (std::size_t firstPosition = nextRow.fetch_add(rowsPerTask); firstPosition < rowOrder.size(); firstPosition = nextRow.fetch_add(rowsPerTask)) {
+		std::vector<std::size_t> rowClassIds;
+		for (std::size_t position = firstPosition; position < std::min(firstPosition + rowsPerTask, rowOrder.size()); position++) {
+			std::size_t classId1 = rowOrder.at(position);
+			std::size_t graphId1 = representatives.at(classId1);
+			if (completedRows[graphId1]) {	// restored from a checkpoint
+				fanOutRow(classId1);
+				continue;
 			}
+			rowClassIds.emplace_back(classId1);
+
+			// the node maps of a row are allocated once it is solved, the map of a graph to itself is the identity
+			if (!distancesOnly) {
+				std::size_t numberOfNodes = snapshots.at(graphId1).numberOfNodes();
+				std::vector<int>& rowNodeMaps = nodeMaps.at(graphId1);
+				rowNodeMaps.assign(snapshots.size() * numberOfNodes, -1);
+				std::iota(rowNodeMaps.begin() + static_cast<long>(graphId1 * numberOfNodes), rowNodeMaps.begin() + static_cast<long>((graphId1 + 1) * numberOfNodes), 0);
+			}
+		}
+
+		for (std::size_t firstColumn = 0; firstColumn < representatives.size() && !rowClassIds.empty(); firstColumn += columnsPerTile) {
+			std::size_t endColumn = std::min(firstColumn + columnsPerTile, representatives.size());
+			std::vector<std::size_t> tileGraphIds;
+			for (std::size_t classId1 : rowClassIds)
+				tileGraphIds.emplace_back(representatives.at(classId1));
+			for (std::size_t classId2 = firstColumn; classId2 < endColumn; classId2++)
+				tileGraphIds.emplace_back(representatives.at(classId2));
+			context.load(tileGraphIds, snapshots);
+
+			for (std::size_t classId1 : rowClassIds) {
+				std::size_t graphId1 = representatives.at(classId1);
+				for (std::size_t classId2 = firstColumn; classId2 < endColumn; classId2++) {
+					if (cancelRequested)
+						return;
+
+					std::size_t graphId2 = representatives.at(classId2);
+					int distance = 0;
+					double gap = 0;
+					if (graphId1 != graphId2) {
+						std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+						double upperBound = context.run(graphId1, snapshots.at(graphId1), graphId2, snapshots.at(graphId2));
+						distance = static_cast<int>(upperBound);
+
+						// the solver returns its best bounds when the budget runs out, but doesn't tell why it stopped. a pair is taken
+						// to have hit the time budget if the solver itself used all of it, and the iteration budget if its bounds didn't meet.
+						if (budgeted) {
+							gap = std::max(upperBound - context.getLowerBound(), 0.0);
+							if ((pairTimeLimit > 0 && context.getSolveSeconds() >= pairTimeLimit) || (pairIterationLimit > 0 && gap > 0))
+								exceededPairs.emplace_back(graphId1, graphId2);
+						}
+						if (solvedPairs++ % sampleStride == 0) {
+							std::chrono::duration<double> seconds = std::chrono::steady_clock::now() - start;
+							const HGCCostModel::GraphFeatures& features1 = graphFeatures.at(graphId1);
+							const HGCCostModel::GraphFeatures& features2 = graphFeatures.at(graphId2);
+							samples.push_back({graphId1, graphId2, HGCCostModel::terms(features1, features2), costModel.predict(methodName, features1, features2), seconds.count()});
+						}
+						if (!distancesOnly) {
+							std::vector<int> images = context.getNodeMap();
+							std::copy(images.begin(), images.end(), nodeMaps.at(graphId1).begin() + static_cast<long>(graphId2 * images.size()));
+						}
+					}
+					for (std::size_t member : classMembers.at(classId2)) {
+						distanceMatrix.at(graphId1).at(member) = distance;
+						if (budgeted)
+							gapMatrix.at(graphId1).at(member) = gap;
+					}
+
+					computedPairs += classMembers.at(classId2).size();
+					if (coordinating)
+						showProgress(static_cast<float>(computedPairs) * scaler);
+				}
+			}
+		}
+
+		for (std::size_t classId1 : rowClassIds)
+			fanOutRow(classId1);
+		if (coordinating)
+			reportCompute(false);
+	}
+}
+
+// writes the rows completed since the last checkpoint into the checkpoint file, if the checkpoint interval has passed or it is the final report
+void HGCGED::reportCompute(bool final) {
+	if (!checkpoint)
+		return;
+	if (!final && std::chrono::steady_clock::now() - lastCheckpoint < checkpointInterval)
+		return;
+
+	for (std::size_t row = 0; row < snapshots.size(); row++) {
+		if (!checkpointedRows.at(row) && completedRows[row].load(std::memory_order_acquire)) {
+			checkpoint->append(row, distanceMatrix.at(row));
+			checkpointedRows.at(row) = true;
+		}
+	}
+	checkpoint->flush();
+	lastCheckpoint = std::chrono::steady_clock::now();
+}
+
+// runs the workers of a computation set up by beginCompute and waits for them to finish
+void HGCGED::runCompute() {
+	float scaler = 100.0f / static_cast<float>(std::max(snapshots.size() * snapshots.size(), static_cast<std::size_t>(1)));
+	std::size_t workers = contexts.size();
+
+	std::vector<std::exception_ptr> errors(workers);
+
+	if (workers == 1) {
+		try {
+			computeRows(0, true);
+		}
+		catch (...) {
+			errors.front() = std::current_exception();
+		}
+	}
+	else {
+		std::atomic<std::size_t> finishedWorkers{0};
+		std::vector<std::thread> threads;
+		for (std::size_t worker = 0; worker < workers; worker++) {
+			threads.emplace_back([this, worker, &finishedWorkers, &errors]() {
+				try {
+					computeRows(worker, false);
+				}
+				catch (...) {
+					errors.at(worker) = std::current_exception();
+					cancelRequested = true;	// lets the other workers stop after their current pair
+				}
+				finishedWorkers++;
+			});
+		}
 
-			std::cout << "\033[A\33[KProgress: " + std::to_string(static_cast<float>(c+1) * scaler) + "%" << std::endl;
-			c++;	// pun intended
+		// the calling thread only reports the progress and writes the checkpoints
+		while (finishedWorkers < workers) {
+			showProgress(static_cast<float>(computedPairs) * scaler);
+			reportCompute(false);
+			std::this_thread::sleep_for(std::chrono::milliseconds(250));
 		}
+		for (std::thread& thread : threads)
+			thread.join();
+	}
+
+	// the completed rows are written even if a worker failed, so that a restarted computation can resume from them
+	reportCompute(true);
+	showProgress(static_cast<float>(computedPairs) * scaler);
+	for (const std::exception_ptr& error : errors) {
+		if (error)
+			std::rethrow_exception(error);
+	}
+}
+
+// collects the pairs which hit the pair budget and lists them with the largest gaps first
+void HGCGED::summarizePairBudget() {
+	for (std::vector<std::pair<std::size_t, std::size_t>>& pairs : workerBudgetExceededPairs)
+		budgetExceededPairs.insert(budgetExceededPairs.end(), pairs.begin(), pairs.end());
+	workerBudgetExceededPairs.clear();
+	if (gapMatrix.empty())
+		return;
+
+	std::stable_sort(budgetExceededPairs.begin(), budgetExceededPairs.end(), [this](const auto& a, const auto& b) {
+		return gapMatrix.at(a.first).at(a.second) > gapMatrix.at(b.first).at(b.second);
+	});
+	double maximumGap = 0;
+	for (const std::vector<double>& row : gapMatrix)
+		maximumGap = std::max(maximumGap, row.empty() ? 0.0 : *std::max_element(row.begin(), row.end()));
+	showInfo(std::to_string(budgetExceededPairs.size()) + " pairs hit the pair budget (largest gap between the bounds: " + std::to_string(maximumGap) + ").");
+
+	std::size_t listedPairs = std::min(budgetExceededPairs.size(), static_cast<std::size_t>(20));
+	for (std::size_t index = 0; index < listedPairs; index++) {
+		const std::pair<std::size_t, std::size_t>& pair = budgetExceededPairs.at(index);
+		showInfo("  \"" + ged_->get_graph_name(pair.first) + "\" - \"" + ged_->get_graph_name(pair.second) + "\": distance " + std::to_string(distanceMatrix.at(pair.first).at(pair.second)) + ", gap " + std::to_string(gapMatrix.at(pair.first).at(pair.second)));
+	}
+	if (listedPairs < budgetExceededPairs.size())
+		showInfo("  ... and " + std::to_string(budgetExceededPairs.size() - listedPairs) + " more, see get_budget_exceeded_pairs.");
+}
 
+// releases the compute state and post-processes the results of a complete computation
+void HGCGED::finishCompute() {
+	calibrateCostModel();
+	summarizePairBudget();
+	releaseSolvers();
+	checkpoint.reset();
+	restoreDistancesOnly();
+
+	peakMemoryUsage = readPeakResidentSetSize();
+	showInfo("Peak memory usage " + std::string(peakResettable ? "during the computation" : "of the process") + ": " + std::to_string(peakMemoryUsage / (1024 * 1024)) + " MiB.");
+
+	std::size_t numberOfCompletedRows = 0;
+	for (std::size_t row = 0; row < distanceMatrix.size(); row++)
+		numberOfCompletedRows += completedRows[row] ? 1 : 0;
+	if (numberOfCompletedRows < distanceMatrix.size()) {
+		showInfo("Computation cancelled with " + std::to_string(numberOfCompletedRows) + " of " + std::to_string(distanceMatrix.size()) + " rows completed.");
+		computeRunning = false;
+		return;
 	}
 
 	if (methodName == "IPFP") { // Makes the distance matrix symmetrical. This should only be nessecary when using a ranomized ged method (which is currently not supported by hgc).
@@ -718,26 +1647,731 @@ void HGCGED::computeGedsGilScope() {
 		}
 	}
 
+	computeRunning = false;
 }
 
-// a helper function that calls a function which contains the actual implementation within a scope in which the GIL is and stays aquired if needed
-void HGCGED::computeGeds() {
+// the actual implementation of the method that computes the ged matrix
+void HGCGED::computeGedsGilScope() {
+
+	// setup console output
+	std::cout << std::fixed << std::setprecision(2) << std::endl;
+	if (ged_ && ged_->num_graphs() == 0) {
+		distanceMatrix.clear();
+		std::cout << "\033[A\33[KEnvironment is empty. Nothing to compute." << std::endl;
+		return;
+	}
+
+	HGC_TRACE_SCOPE("compute geds");
+	HGC_TRACE_BEGIN(beginSpan, "begin compute");
+	beginCompute("", 0);
+	HGC_TRACE_END(beginSpan);
+	try {
+		HGC_TRACE_SCOPE("run compute");
+		runCompute();
+	}
+	catch (...) {
+		finishCompute();
+		throw;
+	}
+	HGC_TRACE_BEGIN(finishSpan, "finish compute");
+	finishCompute();
+	HGC_TRACE_END(finishSpan);
+
+}
+
+// calls the given function within a scope in which the GIL is and stays aquired if needed
+void HGCGED::callInGilScope(const std::function<void()>& function) {
 	if (customEditCosts) {
 		showWarning("Using custom edit costs significantly decreases performance, especially when used with multi-threading!");
 		if (!customEditCosts->multiThreaded) {
 			pybind11::gil_scoped_acquire acquire;
-			computeGedsGilScope();
+			function();
 		}
 		else
-			computeGedsGilScope();
+			function();
 	}
 	else
-		computeGedsGilScope();
+		function();
 }
 
-#pragma endregion
+// a helper function that calls a function which contains the actual implementation within a scope in which the GIL is and stays aquired if needed
+void HGCGED::computeGeds() {
+	callInGilScope([this]() { computeGedsGilScope(); });
+}
 
-#pragma region pybind11
+// selects landmark graphs, computes the exact geds between them and all graphs and embeds all graphs from these distances. uses random
+// selection, k-center (farthest first) selection or selection stratified by the label vector. the number of solved pairs is linear in the
+// number of graphs.
+void HGCGED::computeApproximateGedsGilScope(std::size_t numberOfLandmarks, const std::string& selection, std::size_t dimension, std::size_t seed) {
+
+	// security
+	if (!ged_)
+		throwError("Couldn't compute approximate graph edit distances:", "HGC environment not constructed.");
+	if (computeRunning)
+		throwError("Couldn't compute approximate graph edit distances:", "Another computation is still running.");
+	if (selection != "random" && selection != "kcenter" && selection != "stratified")
+		throwError("Couldn't compute approximate graph edit distances:", "\"" + selection + "\" is an invalid landmark selection. Use \"random\", \"kcenter\" or \"stratified\".");
+	if (selection == "stratified" && labelVector.size() != ged_->num_graphs())
+		throwError("Couldn't compute approximate graph edit distances:", "Stratified landmark selection needs the labels of all graphs. Generate them first.");
+
+	std::size_t numberOfGraphs = ged_->num_graphs();
+	numberOfLandmarks = std::min(numberOfLandmarks, numberOfGraphs);
+	landmarkEmbedding.reset();
+	if (numberOfLandmarks == 0) {
+		showInfo("Environment is empty or no landmarks requested. Nothing to compute.");
+		return;
+	}
+
+	prepareSolvers();
+	std::mt19937_64 generator(seed);
+	std::vector<std::size_t> landmarks;
+	std::vector<std::vector<double>> landmarkDistances;
+
+	auto solveLandmarkRows = [this, numberOfGraphs, &landmarks, &landmarkDistances](std::size_t firstLandmark) {
+		std::vector<std::pair<std::size_t, std::size_t>> pairs;
+		for (std::size_t landmark = firstLandmark; landmark < landmarks.size(); landmark++) {
+			for (std::size_t graphId = 0; graphId < numberOfGraphs; graphId++)
+				pairs.emplace_back(landmarks.at(landmark), graphId);
+		}
+		std::vector<double> distances = solvePairs(pairs);
+		for (std::size_t landmark = firstLandmark; landmark < landmarks.size(); landmark++) {
+			auto begin = distances.begin() + static_cast<std::ptrdiff_t>((landmark - firstLandmark) * numberOfGraphs);
+			landmarkDistances.emplace_back(begin, begin + static_cast<std::ptrdiff_t>(numberOfGraphs));
+		}
+	};
+
+	try {
+		if (selection == "kcenter") {
+			// every new landmark is the graph farthest away from all previous landmarks
+			std::vector<double> minimumDistances(numberOfGraphs, std::numeric_limits<double>::infinity());
+			landmarks.emplace_back(std::uniform_int_distribution<std::size_t>(0, numberOfGraphs - 1)(generator));
+			while (true) {
+				solveLandmarkRows(landmarks.size() - 1);
+				for (std::size_t graphId = 0; graphId < numberOfGraphs; graphId++)
+					minimumDistances.at(graphId) = std::min(minimumDistances.at(graphId), landmarkDistances.back().at(graphId));
+				if (landmarks.size() == numberOfLandmarks)
+					break;
+				landmarks.emplace_back(static_cast<std::size_t>(std::max_element(minimumDistances.begin(), minimumDistances.end()) - minimumDistances.begin()));
+				showProgress(100.0f * static_cast<float>(landmarks.size()) / static_cast<float>(numberOfLandmarks));
+			}
+		}
+		else {
+			std::vector<std::size_t> graphIds(numberOfGraphs);
+			std::iota(graphIds.begin(), graphIds.end(), 0);
+			std::shuffle(graphIds.begin(), graphIds.end(), generator);
+
+			if (selection == "random") {
+				landmarks.assign(graphIds.begin(), graphIds.begin() + static_cast<std::ptrdiff_t>(numberOfLandmarks));
+			}
+			else {
+				// every stratum gets landmarks proportional to its size, but at least one
+				std::map<std::string, std::vector<std::size_t>> strata;
+				for (std::size_t graphId : graphIds) {
+					const std::string& label = labelVector.at(graphId);
+					strata[label.substr(label.find('_') + 1)].emplace_back(graphId);
+				}
+				for (const std::pair<const std::string, std::vector<std::size_t>>& stratum : strata) {
+					auto quota = static_cast<std::size_t>(std::llround(static_cast<double>(numberOfLandmarks * stratum.second.size()) / static_cast<double>(numberOfGraphs)));
+					quota = std::min(std::max(quota, static_cast<std::size_t>(1)), stratum.second.size());
+					landmarks.insert(landmarks.end(), stratum.second.begin(), stratum.second.begin() + static_cast<std::ptrdiff_t>(quota));
+				}
+				std::shuffle(landmarks.begin(), landmarks.end(), generator);
+				if (landmarks.size() > numberOfLandmarks)
+					landmarks.resize(numberOfLandmarks);
+				for (std::size_t index = 0; landmarks.size() < numberOfLandmarks && index < graphIds.size(); index++) {
+					if (std::find(landmarks.begin(), landmarks.end(), graphIds.at(index)) == landmarks.end())
+						landmarks.emplace_back(graphIds.at(index));
+				}
+			}
+			solveLandmarkRows(0);
+		}
+	}
+	catch (...) {
+		releaseSolvers();
+		throw;
+	}
+	releaseSolvers();
+
+	landmarkEmbedding = std::make_unique<HGCLandmarkEmbedding>(landmarks, landmarkDistances, dimension);
+
+	// estimate the error bound from the gap between the triangle inequality bounds on a sample of pairs
+	std::uniform_int_distribution<std::size_t> graphDistribution(0, numberOfGraphs - 1);
+	double meanGap = 0;
+	double maximumGap = 0;
+	std::size_t numberOfSamples = std::min(numberOfGraphs * numberOfGraphs, static_cast<std::size_t>(10000));
+	for (std::size_t sample = 0; sample < numberOfSamples; sample++) {
+		std::size_t graphId1 = graphDistribution(generator);
+		std::size_t graphId2 = graphDistribution(generator);
+		double gap = landmarkEmbedding->upperBound(graphId1, graphId2) - landmarkEmbedding->lowerBound(graphId1, graphId2);
+		meanGap += gap / static_cast<double>(numberOfSamples);
+		maximumGap = std::max(maximumGap, gap);
+	}
+	showInfo("Embedded " + std::to_string(numberOfGraphs) + " graphs into " + std::to_string(landmarkEmbedding->getDimension()) + " dimensions using " + std::to_string(landmarks.size()) + " landmarks (" + std::to_string(landmarks.size() * numberOfGraphs) + " instead of " + std::to_string(numberOfGraphs * numberOfGraphs) + " pairs solved).");
+	showInfo("The approximate distances lie within bounds of width " + std::to_string(meanGap) + " on average and at most " + std::to_string(maximumGap) + " on a sample of " + std::to_string(numberOfSamples) + " pairs.");
+}
+
+// a helper function that calls computeApproximateGedsGilScope within a scope in which the GIL is and stays aquired if needed
+void HGCGED::computeApproximateGeds(std::size_t numberOfLandmarks, const std::string& selection, std::size_t dimension, std::size_t seed) {
+	callInGilScope([this, numberOfLandmarks, &selection, dimension, seed]() { computeApproximateGedsGilScope(numberOfLandmarks, selection, dimension, seed); });
+}
+
+// computes the geds of the given pairs of graph ids only, in parallel on the solver contexts, and returns them in the order of the pairs
+std::vector<double> HGCGED::computeGedsPairsGilScope(const std::vector<std::pair<std::size_t, std::size_t>>& pairs) {
+
+	// security
+	if (!ged_)
+		throwError("Couldn't compute graph edit distances:", "HGC environment not constructed.");
+	if (computeRunning)
+		throwError("Couldn't compute graph edit distances:", "Another computation is still running.");
+	for (const std::pair<std::size_t, std::size_t>& pair : pairs) {
+		if (pair.first >= ged_->num_graphs() || pair.second >= ged_->num_graphs())
+			throwError("Couldn't compute graph edit distances:", "The pair (" + std::to_string(pair.first) + ", " + std::to_string(pair.second) + ") contains a graph which is not contained in the environment.");
+	}
+	if (pairs.empty())
+		return {};
+
+	prepareSolvers();
+	std::vector<double> distances;
+	try {
+		distances = solvePairs(pairs);
+	}
+	catch (...) {
+		releaseSolvers();
+		throw;
+	}
+	releaseSolvers();
+
+	return distances;
+}
+
+// a helper function that calls computeGedsPairsGilScope within a scope in which the GIL is and stays aquired if needed
+std::vector<double> HGCGED::computeGedsPairs(const std::vector<std::pair<std::size_t, std::size_t>>& pairs) {
+	std::vector<double> distances;
+	callInGilScope([this, &pairs, &distances]() { distances = computeGedsPairsGilScope(pairs); });
+	return distances;
+}
+
+// computes the geds between every query and every reference graph, e.g. to place new samples into an existing cohort without
+// recomputing its matrix. returns the distances row-major, a row per query.
+std::vector<double> HGCGED::computeGedsBlock(const std::vector<std::size_t>& queryIds, const std::vector<std::size_t>& referenceIds) {
+	std::vector<std::pair<std::size_t, std::size_t>> pairs;
+	pairs.reserve(queryIds.size() * referenceIds.size());
+	for (std::size_t queryId : queryIds) {
+		for (std::size_t referenceId : referenceIds)
+			pairs.emplace_back(queryId, referenceId);
+	}
+	return computeGedsPairs(pairs);
+}
+
+// computes the geds of all pairs i < j directly into a memory-mapped condensed matrix file (see HGCMappedMatrix), so the matrix never
+// has to fit into memory. the workers take square tiles of the upper triangle, so each of them only dirties a few pages at a time.
+// the distance of a pair is computed in one direction only. the file is complete once its header says so, a cancelled or failed
+// computation leaves it incomplete.
+void HGCGED::computeGedsMappedGilScope(const std::string& path) {
+
+	// security
+	if (!ged_)
+		throwError("Couldn't compute graph edit distances:", "HGC environment not constructed.");
+	if (computeRunning)
+		throwError("Couldn't compute graph edit distances:", "Another computation is still running.");
+
+	HGC_TRACE_SCOPE("compute mapped geds");
+	std::cout << std::fixed << std::setprecision(2) << std::endl;
+	std::size_t numberOfGraphs = ged_->num_graphs();
+	std::size_t numberOfPairs = numberOfGraphs < 2 ? 0 : numberOfGraphs * (numberOfGraphs - 1) / 2;
+
+	prepareSolvers();
+	computeRunning = true;
+	cancelRequested = false;
+	computedPairs = 0;
+	try {
+		HGCMappedMatrix matrix(path, numberOfGraphs, computeFingerprint());
+
+		constexpr std::size_t tileSize = 64;
+		std::vector<std::pair<std::size_t, std::size_t>> tiles;
+		for (std::size_t firstRow = 0; firstRow < numberOfGraphs; firstRow += tileSize) {
+			for (std::size_t firstColumn = firstRow; firstColumn < numberOfGraphs; firstColumn += tileSize)
+				tiles.emplace_back(firstRow, firstColumn);
+		}
+
+		std::atomic<std::size_t> nextTile{0};
+		auto solveTiles = [this, &matrix, &tiles, &nextTile, numberOfGraphs, numberOfPairs](std::size_t worker) {
+			HGCSolverContext<HGCNodeLabel, HGCEdgeLabel>& context = *contexts.at(worker);
+			for (std::size_t tile = nextTile++; tile < tiles.size() && !cancelRequested; tile = nextTile++) {
+				auto [firstRow, firstColumn] = tiles.at(tile);
+				for (std::size_t graphId1 = firstRow; graphId1 < std::min(firstRow + tileSize, numberOfGraphs); graphId1++) {
+					for (std::size_t graphId2 = std::max(firstColumn, graphId1 + 1); graphId2 < std::min(firstColumn + tileSize, numberOfGraphs); graphId2++) {
+						matrix.set(graphId1, graphId2, static_cast<int>(context.run(graphId1, snapshots.at(graphId1), graphId2, snapshots.at(graphId2))));
+						computedPairs++;
+					}
+				}
+				if (worker == 0)
+					showProgress(static_cast<float>(computedPairs) * 100.f / static_cast<float>(numberOfPairs));
+			}
+		};
+
+		std::vector<std::exception_ptr> errors(contexts.size());
+		auto runWorker = [&solveTiles, &errors, &nextTile, &tiles](std::size_t worker) {
+			try {
+				solveTiles(worker);
+			}
+			catch (...) {
+				errors.at(worker) = std::current_exception();
+				nextTile = tiles.size();
+			}
+		};
+		std::vector<std::thread> threads;
+		for (std::size_t worker = 1; worker < contexts.size(); worker++)
+			threads.emplace_back(runWorker, worker);
+		runWorker(0);
+		for (std::thread& thread : threads)
+			thread.join();
+		for (const std::exception_ptr& error : errors) {
+			if (error)
+				std::rethrow_exception(error);
+		}
+
+		if (computedPairs == numberOfPairs)
+			matrix.markComplete();
+		else
+			showInfo("Computation cancelled with " + std::to_string(computedPairs) + " of " + std::to_string(numberOfPairs) + " pairs written to \"" + path + "\".");
+	}
+	catch (...) {
+		releaseSolvers();
+		computeRunning = false;
+		throw;
+	}
+	releaseSolvers();
+	computeRunning = false;
+}
+
+// a helper function that calls computeGedsMappedGilScope within a scope in which the GIL is and stays aquired if needed
+void HGCGED::computeGedsMapped(const std::string& path) {
+	callInGilScope([this, &path]() { computeGedsMappedGilScope(path); });
+}
+
+// clusters the graphs by single linkage on their geds, i.e. by the minimum spanning tree of the complete ged graph, without
+// computing all geds. the lower bounds of BRANCH_FAST are computed for all pairs first. prim's algorithm then keeps its candidate
+// edges in a queue keyed by their lower bound until they reach the front, and only then solves them with the configured method, in
+// batches of one pair per worker. an edge whose lower bound is not smaller than the best solved edge to the same graph is dropped
+// unsolved. returns the merges in scipy's linkage format.
+std::vector<HGCClustering::Merge> HGCGED::computeSingleLinkageGilScope() {
+
+	// security
+	if (!ged_)
+		throwError("Couldn't compute single linkage:", "HGC environment not constructed.");
+	if (computeRunning)
+		throwError("Couldn't compute single linkage:", "Another computation is still running.");
+
+	HGC_TRACE_SCOPE("compute single linkage");
+	std::size_t numberOfGraphs = ged_->num_graphs();
+	lazyLinkageStatistics.clear();
+	if (numberOfGraphs < 2)
+		return {};
+
+	std::vector<std::pair<std::size_t, std::size_t>> pairs;
+	pairs.reserve(numberOfGraphs * (numberOfGraphs - 1) / 2);
+	for (std::size_t graphId1 = 0; graphId1 < numberOfGraphs; graphId1++) {
+		for (std::size_t graphId2 = graphId1 + 1; graphId2 < numberOfGraphs; graphId2++)
+			pairs.emplace_back(graphId1, graphId2);
+	}
+
+	std::vector<HGCClustering::Merge> merges;
+	prepareSolvers();
+	try {
+
+		// bounds, using solver contexts of the fast method in place of the configured ones. if the configured method is the fast
+		// one, its upper bounds are the distances, so every edge is solved right away. the options of the configured method, e.g.
+		// the iterations of BRANCH_TIGHT, don't apply to the fast method.
+		std::vector<double> lowerBounds;
+		std::vector<double> fastUpperBounds;
+		{
+			HGC_TRACE_SCOPE("lower bounds");
+			std::vector<std::unique_ptr<HGCSolverContext<HGCNodeLabel, HGCEdgeLabel>>> boundContexts;
+			for (std::size_t worker = 0; worker < contexts.size(); worker++)
+				boundContexts.emplace_back(std::make_unique<HGCSolverContext<HGCNodeLabel, HGCEdgeLabel>>(getEditCosts(), ged::Options::GEDMethod::BRANCH_FAST, "--threads 1"));
+			std::swap(contexts, boundContexts);
+			try {
+				fastUpperBounds = solvePairs(pairs, &lowerBounds);
+			}
+			catch (...) {
+				std::swap(contexts, boundContexts);
+				throw;
+			}
+			std::swap(contexts, boundContexts);
+		}
+		bool boundsAreDistances = methodName == "BRANCH_FAST";
+		auto pairIndex = [numberOfGraphs](std::size_t graphId1, std::size_t graphId2) { return HGCMappedMatrix::condensedIndex(numberOfGraphs, graphId1, graphId2); };
+
+		// prim's algorithm on lazily solved edges. at equal keys solved edges come first, so that they are added before edges
+		// which could at best tie with them are solved.
+		struct Candidate {
+			double key;
+			bool solved;
+			std::size_t treeGraphId;
+			std::size_t graphId;
+		};
+		auto later = [](const Candidate& a, const Candidate& b) { return a.key != b.key ? a.key > b.key : (a.solved != b.solved ? b.solved : a.graphId > b.graphId); };
+		std::priority_queue<Candidate, std::vector<Candidate>, decltype(later)> candidates(later);
+		std::vector<bool> inTree(numberOfGraphs, false);
+		std::vector<double> bestSolved(numberOfGraphs, std::numeric_limits<double>::infinity());
+		std::vector<std::tuple<std::size_t, std::size_t, double>> treeEdges;
+		std::size_t solvedEdges = 0;
+
+		auto addToTree = [&](std::size_t graphId) {
+			inTree.at(graphId) = true;
+			for (std::size_t other = 0; other < numberOfGraphs; other++) {
+				if (inTree.at(other))
+					continue;
+				std::size_t index = pairIndex(graphId, other);
+				if (boundsAreDistances) {
+					candidates.push({fastUpperBounds.at(index), true, graphId, other});
+					bestSolved.at(other) = std::min(bestSolved.at(other), fastUpperBounds.at(index));
+				}
+				else if (lowerBounds.at(index) < bestSolved.at(other))
+					candidates.push({lowerBounds.at(index), false, graphId, other});
+			}
+		};
+
+		HGC_TRACE_BEGIN(treeSpan, "spanning tree");
+		addToTree(0);
+		while (treeEdges.size() + 1 < numberOfGraphs) {
+			std::vector<Candidate> batch;
+			while (!candidates.empty() && batch.size() < contexts.size()) {
+				const Candidate& front = candidates.top();
+				if (inTree.at(front.graphId) || (!front.solved && front.key >= bestSolved.at(front.graphId))) {
+					candidates.pop();
+					continue;
+				}
+				if (front.solved)
+					break;
+				batch.push_back(front);
+				candidates.pop();
+			}
+
+			if (!batch.empty()) {
+				std::vector<std::pair<std::size_t, std::size_t>> batchPairs;
+				for (const Candidate& candidate : batch)
+					batchPairs.emplace_back(std::min(candidate.treeGraphId, candidate.graphId), std::max(candidate.treeGraphId, candidate.graphId));
+				std::vector<double> distances = solvePairs(batchPairs);
+				solvedEdges += batch.size();
+				for (std::size_t index = 0; index < batch.size(); index++) {
+					candidates.push({distances.at(index), true, batch.at(index).treeGraphId, batch.at(index).graphId});
+					bestSolved.at(batch.at(index).graphId) = std::min(bestSolved.at(batch.at(index).graphId), distances.at(index));
+				}
+				continue;
+			}
+
+			Candidate nearest = candidates.top();
+			candidates.pop();
+			treeEdges.emplace_back(nearest.treeGraphId, nearest.graphId, nearest.key);
+			addToTree(nearest.graphId);
+		}
+		HGC_TRACE_END(treeSpan);
+
+		merges = HGCClustering::linkageFromSpanningTree(treeEdges, numberOfGraphs);
+
+		lazyLinkageStatistics["pairs"] = pairs.size();
+		lazyLinkageStatistics["bound solves"] = pairs.size();
+		lazyLinkageStatistics["exact solves"] = boundsAreDistances ? pairs.size() : solvedEdges;
+		lazyLinkageStatistics["avoided exact solves"] = boundsAreDistances ? 0 : pairs.size() - solvedEdges;
+		showInfo("Single linkage solved " + std::to_string(lazyLinkageStatistics["exact solves"]) + " of " + std::to_string(pairs.size()) + " pairs with the " + methodName + " method, " + std::to_string(lazyLinkageStatistics["avoided exact solves"]) + " exact solves were avoided.");
+	}
+	catch (...) {
+		releaseSolvers();
+		throw;
+	}
+	releaseSolvers();
+
+	return merges;
+}
+
+// a helper function that calls computeSingleLinkageGilScope within a scope in which the GIL is and stays aquired if needed
+std::vector<HGCClustering::Merge> HGCGED::computeSingleLinkage() {
+	std::vector<HGCClustering::Merge> merges;
+	callInGilScope([this, &merges]() { merges = computeSingleLinkageGilScope(); });
+	return merges;
+}
+
+// computes one ged matrix per setting of the node factor and the insert/delete factor of the dataset edit costs, given as pairs in
+// settings. every pair i < j is solved once under the current factors and only the terms of its edit path are kept, from which its
+// cost under every setting follows in constant time. the rescored path is an upper bound on the ged of the setting, which is exact if
+// the path stays optimal. if resolveGap is not negative, pairs whose rescored cost exceeds the lower bound given by the differences of
+// the numbers of nodes and edges by more than that fraction of their cost are solved again under the setting, keeping the smaller
+// cost. returns the symmetric matrices one after another in a flat vector, row by row.
+std::vector<double> HGCGED::computeCostSweepGilScope(const std::vector<std::pair<double, double>>& settings, double resolveGap) {
+
+	// security
+	if (!ged_)
+		throwError("Couldn't compute cost sweep:", "HGC environment not constructed.");
+	if (computeRunning)
+		throwError("Couldn't compute cost sweep:", "Another computation is still running.");
+	if (editCostsName != "dataset" || !datasetEditCosts)
+		throwError("Couldn't compute cost sweep:", "The factors only exist for the edit costs of a costs dataset.");
+	for (const std::pair<double, double>& setting : settings) {
+		if (setting.first < 0 || setting.first > 1 || setting.second < 0 || setting.second > 1)
+			throwError("Couldn't compute cost sweep:", "The factors have to lie between 0 and 1.");
+	}
+
+	HGC_TRACE_SCOPE("compute cost sweep");
+	std::size_t numberOfGraphs = ged_->num_graphs();
+	std::vector<double> matrices(settings.size() * numberOfGraphs * numberOfGraphs, 0);
+	costSweepStatistics.clear();
+	if (numberOfGraphs < 2 || settings.empty())
+		return matrices;
+
+	std::vector<std::pair<std::size_t, std::size_t>> pairs;
+	pairs.reserve(numberOfGraphs * (numberOfGraphs - 1) / 2);
+	for (std::size_t graphId1 = 0; graphId1 < numberOfGraphs; graphId1++) {
+		for (std::size_t graphId2 = graphId1 + 1; graphId2 < numberOfGraphs; graphId2++)
+			pairs.emplace_back(graphId1, graphId2);
+	}
+
+	using PathTerms = HGCCosts<HGCNodeLabel, HGCEdgeLabel>::PathTerms;
+	std::vector<PathTerms> terms(pairs.size());
+	std::size_t resolvedPairs = 0;
+	prepareSolvers();
+	try {
+		{
+			HGC_TRACE_SCOPE("solve pairs");
+			solvePairs(pairs, nullptr, [this, &pairs, &terms](std::size_t index, const HGCSolverContext<HGCNodeLabel, HGCEdgeLabel>& context) {
+				const std::pair<std::size_t, std::size_t>& pair = pairs.at(index);
+				terms.at(index) = datasetEditCosts->pathTerms(snapshots.at(pair.first), snapshots.at(pair.second), context.getNodeMap());
+			});
+		}
+
+		for (std::size_t setting = 0; setting < settings.size(); setting++) {
+			double nodeFactor = settings.at(setting).first;
+			double insertDeleteFactor = settings.at(setting).second;
+			double* matrix = matrices.data() + setting * numberOfGraphs * numberOfGraphs;
+			std::vector<double> costs(pairs.size());
+			std::vector<std::size_t> resolveIndices;
+			for (std::size_t index = 0; index < pairs.size(); index++) {
+				costs.at(index) = HGCCosts<HGCNodeLabel, HGCEdgeLabel>::pathCost(terms.at(index), nodeFactor, insertDeleteFactor);
+				if (resolveGap < 0)
+					continue;
+				const HGCGraphSnapshot<HGCNodeLabel, HGCEdgeLabel>& graph1 = snapshots.at(pairs.at(index).first);
+				const HGCGraphSnapshot<HGCNodeLabel, HGCEdgeLabel>& graph2 = snapshots.at(pairs.at(index).second);
+				auto difference = [](std::size_t a, std::size_t b) { return static_cast<double>(a > b ? a - b : b - a); };
+				double sizeBound = insertDeleteFactor * nodeFactor * difference(graph1.numberOfNodes(), graph2.numberOfNodes())
+								   + insertDeleteFactor * (1 - nodeFactor) * difference(graph1.numberOfEdges(), graph2.numberOfEdges());
+				if (costs.at(index) - sizeBound > resolveGap * costs.at(index))
+					resolveIndices.emplace_back(index);
+			}
+
+			// solve the pairs again with edit costs of the setting, using solver contexts of the setting in place of the configured ones
+			if (!resolveIndices.empty()) {
+				HGC_TRACE_SCOPE("resolve pairs");
+				HGCCosts<HGCNodeLabel, HGCEdgeLabel> settingCosts(*datasetEditCosts);
+				settingCosts.setFactors(nodeFactor, insertDeleteFactor);
+				std::vector<std::unique_ptr<HGCSolverContext<HGCNodeLabel, HGCEdgeLabel>>> settingContexts;
+				for (std::size_t worker = 0; worker < contexts.size(); worker++)
+					settingContexts.emplace_back(std::make_unique<HGCSolverContext<HGCNodeLabel, HGCEdgeLabel>>(&settingCosts, loadMethod(methodName), solverArguments()));
+				std::vector<std::pair<std::size_t, std::size_t>> resolvePairs;
+				for (std::size_t index : resolveIndices)
+					resolvePairs.emplace_back(pairs.at(index));
+
+				std::swap(contexts, settingContexts);
+				std::vector<double> resolvedCosts;
+				try {
+					resolvedCosts = solvePairs(resolvePairs);
+				}
+				catch (...) {
+					std::swap(contexts, settingContexts);
+					throw;
+				}
+				std::swap(contexts, settingContexts);
+				for (std::size_t position = 0; position < resolveIndices.size(); position++)
+					costs.at(resolveIndices.at(position)) = std::min(costs.at(resolveIndices.at(position)), resolvedCosts.at(position));
+				resolvedPairs += resolveIndices.size();
+			}
+
+			for (std::size_t index = 0; index < pairs.size(); index++) {
+				matrix[pairs.at(index).first * numberOfGraphs + pairs.at(index).second] = costs.at(index);
+				matrix[pairs.at(index).second * numberOfGraphs + pairs.at(index).first] = costs.at(index);
+			}
+			showProgress(100.0f * static_cast<float>(setting + 1) / static_cast<float>(settings.size()));
+		}
+	}
+	catch (...) {
+		releaseSolvers();
+		throw;
+	}
+	releaseSolvers();
+
+	costSweepStatistics = {
+			{"pairs", pairs.size()},
+			{"settings", settings.size()},
+			{"solved pairs", pairs.size() + resolvedPairs},
+			{"resolved pairs", resolvedPairs}
+	};
+	showInfo("Cost sweep over " + std::to_string(settings.size()) + " settings solved " + std::to_string(pairs.size() + resolvedPairs) + " pairs instead of " + std::to_string(pairs.size() * settings.size()) + " (" + std::to_string(resolvedPairs) + " solved again).");
+	return matrices;
+}
+
+// a helper function that calls computeCostSweepGilScope within a scope in which the GIL is and stays aquired if needed
+std::vector<double> HGCGED::computeCostSweep(const std::vector<std::pair<double, double>>& settings, double resolveGap) {
+	std::vector<double> matrices;
+	callInGilScope([this, &settings, resolveGap, &matrices]() { matrices = computeCostSweepGilScope(settings, resolveGap); });
+	return matrices;
+}
+
+// estimates the stability of the clustering of the ged matrix by bootstrap or jackknife resampling (see HGCBootstrap) and stores the
+// support of each merge of the reference clustering and the co-clustering frequencies of the graphs. the reference clustering is given
+// as a linkage matrix in scipy's format, if it is empty it is computed with the given algorithm like HGCGEDExec does. no ged is
+// computed again, so the ged matrix has to be complete.
+void HGCGED::computeClusteringStability(const std::string& algorithm, const std::string& mode, std::size_t numberOfResamples, double fraction,
+										std::size_t numberOfClusters, std::size_t seed, const std::vector<std::vector<double>>& referenceLinkage) {
+
+	// security
+	if (computeRunning)
+		throwError("Couldn't compute clustering stability:", "Another computation is still running.");
+	if (distanceMatrix.size() < 2)
+		throwError("Couldn't compute clustering stability:", "The GED matrix has to be computed first.");
+	for (const std::vector<int>& row : distanceMatrix) {
+		if (std::find(row.begin(), row.end(), -1) != row.end())
+			throwError("Couldn't compute clustering stability:", "The GED matrix is incomplete.");
+	}
+	if (numberOfResamples == 0)
+		throwError("Couldn't compute clustering stability:", "At least one resample is needed.");
+
+	HGC_TRACE_SCOPE("compute clustering stability");
+	std::string method = HGCClustering::parseAlgorithm(algorithm);
+	std::size_t numberOfGraphs = distanceMatrix.size();
+	std::size_t workers = std::max(std::min(numberOfWorkers, numberOfResamples), static_cast<std::size_t>(1));
+
+	std::vector<HGCClustering::Merge> reference;
+	if (referenceLinkage.empty())
+		reference = HGCClustering::linkage(HGCClustering::rowDistances(distanceMatrix, workers), numberOfGraphs, method);
+	else {
+		if (referenceLinkage.size() + 1 != numberOfGraphs)
+			throwError("Couldn't compute clustering stability:", "The reference clustering has " + std::to_string(referenceLinkage.size() + 1) + " leaves, but there are " + std::to_string(numberOfGraphs) + " graphs.");
+		for (const std::vector<double>& row : referenceLinkage) {
+			if (row.size() < 4)
+				throwError("Couldn't compute clustering stability:", "The rows of the reference linkage matrix need four columns.");
+			reference.push_back({static_cast<std::size_t>(row.at(0)), static_cast<std::size_t>(row.at(1)), row.at(2), static_cast<std::size_t>(row.at(3))});
+		}
+	}
+
+	HGCBootstrap::Result result;
+	try {
+		result = HGCBootstrap::run(distanceMatrix, reference, method, mode, numberOfResamples, fraction, numberOfClusters, seed, workers);
+	}
+	catch (const std::runtime_error& error) {
+		throwError("Couldn't compute clustering stability:", error.what());
+	}
+	bootstrapSupport = std::move(result.support);
+	coClusteringFrequencies = std::move(result.coClustering);
+
+	std::size_t stableMerges = 0;
+	for (double support : bootstrapSupport)
+		stableMerges += support >= 0.95 ? 1 : 0;
+	showInfo("Clustering stability over " + std::to_string(numberOfResamples) + " " + mode + " resamples: " + std::to_string(stableMerges) + " of " + std::to_string(bootstrapSupport.size()) + " merges have a support of at least 95%.");
+}
+
+// writes the condensed euclidean distances between the rows of a condensed ged matrix (e.g. a mapped distance matrix) into the output,
+// so that a mapped matrix is clustered by the same distances as the matrix in memory
+void HGCGED::computeRowDistances(const std::int32_t* condensed, std::size_t numberOfGraphs, double* output) {
+	HGC_TRACE_SCOPE("row distances");
+	HGCClustering::condensedRowDistances(condensed, numberOfGraphs, output, numberOfWorkers);
+}
+
+// orders the leaves of the dendrogram so that adjacent leaves are close by the given distances (see HGCDendrogram) and returns the
+// merges with their children swapped accordingly, like scipy's optimal_ordering. subtrees with at most exactThreshold leaves are
+// ordered optimally, the merges above them greedily.
+std::vector<HGCClustering::Merge> HGCGED::orderLeaves(const std::vector<HGCClustering::Merge>& merges, const HGCDendrogram::DistanceFunction& distance, std::size_t exactThreshold) {
+	HGC_TRACE_SCOPE("order leaves");
+	std::size_t numberOfLeaves = merges.size() + 1;
+	std::vector<std::size_t> order;
+	try {
+		order = HGCDendrogram::optimalLeafOrder(merges, numberOfLeaves, distance, exactThreshold, numberOfWorkers);
+	}
+	catch (const std::runtime_error& error) {
+		throwError("Couldn't order leaves:", error.what());
+	}
+	if (numberOfLeaves > exactThreshold)
+		showInfo("The " + std::to_string(numberOfLeaves) + " leaves were ordered optimally within the subtrees of at most " + std::to_string(exactThreshold) + " leaves and greedily above them.");
+	return HGCDendrogram::applyLeafOrder(merges, numberOfLeaves, order);
+}
+
+// starts computing the ged matrix in the background and returns a handle to the computation. if a checkpoint path is passed, the
+// completed rows are written into it every checkpointIntervalSeconds seconds and a computation restarted with the same path resumes from it.
+HGCComputeHandle HGCGED::startCompute(const std::string& checkpointPath = "", std::size_t checkpointIntervalSeconds = 60) {
+	if (computeRunning)
+		throwError("Couldn't start computation:", "Another computation is still running.");
+	joinComputeThread();
+
+	// the background thread never holds the gil, so custom edit costs have to acquire it on every call. this has to be known before
+	// the solvers are prepared, which decides whether the dispatcher is started, and is undone once the computation is joined.
+	if (customEditCosts) {
+		asyncMultiThreaded = customEditCosts->multiThreaded;
+		customEditCosts->multiThreaded = true;
+	}
+
+	std::cout << std::fixed << std::setprecision(2) << std::endl;
+	try {
+		beginCompute(checkpointPath, checkpointIntervalSeconds);
+	}
+	catch (...) {
+		joinComputeThread();
+		throw;
+	}
+
+	computeThread = std::thread([this]() {
+		try {
+			runCompute();
+		}
+		catch (...) {
+			computeError = std::current_exception();
+		}
+		finishCompute();
+	});
+
+	return HGCComputeHandle(this);
+}
+
+// joins the thread of the last background computation, if any, and restores the threading flag of the custom edit costs on the calling side
+void HGCGED::joinComputeThread() {
+	if (computeThread.joinable())
+		computeThread.join();
+	if (customEditCosts && asyncMultiThreaded) {
+		customEditCosts->multiThreaded = *asyncMultiThreaded;
+		asyncMultiThreaded.reset();
+	}
+}
+
+// returns the fraction of pairs of the current or last computation that have been computed
+double HGCGED::getComputeProgress() {
+	std::size_t numberOfPairs = distanceMatrix.size() * distanceMatrix.size();
+	if (numberOfPairs == 0)
+		return 1.0;
+	return static_cast<double>(computedPairs) / static_cast<double>(numberOfPairs);
+}
+
+// returns whether a computation is currently running
+bool HGCGED::isComputeRunning() {
+	return computeRunning;
+}
+
+// requests the running computation to stop after the pairs which are currently solved. the completed rows are kept.
+void HGCGED::cancelCompute() {
+	cancelRequested = true;
+}
+
+// waits for the computation started by startCompute to finish and rethrows its error, if one occurred
+void HGCGED::waitCompute() {
+	joinComputeThread();
+
+	if (computeError) {
+		std::exception_ptr error = computeError;
+		computeError = nullptr;
+		std::rethrow_exception(error);
+	}
+}
+
+#pragma endregion
+
+#pragma region pybind11
 
 #pragma region get
 
@@ -746,6 +2380,197 @@ std::vector<std::vector<int>> HGCGED::getDistanceMatrix() {
 	return distanceMatrix;
 }
 
+// returns the rows of the GED matrix that have been completed so far. rows which are not completed yet contain -1.
+std::vector<std::vector<int>> HGCGED::getPartialDistanceMatrix() {
+	if (!completedRows)
+		return distanceMatrix;
+
+	std::vector<std::vector<int>> partialDistanceMatrix(distanceMatrix.size(), std::vector<int>(distanceMatrix.size(), -1));
+	for (std::size_t row = 0; row < distanceMatrix.size(); row++) {
+		if (completedRows[row].load(std::memory_order_acquire))
+			partialDistanceMatrix.at(row) = distanceMatrix.at(row);
+	}
+	return partialDistanceMatrix;
+}
+
+// returns the gap between the upper and the lower bound of every pair of the last computation, which is 0 for pairs solved to
+// optimality. empty if no pair budget was set.
+std::vector<std::vector<double>> HGCGED::getGapMatrix() {
+	return gapMatrix;
+}
+
+// returns the pairs of the last computation which hit the pair budget, with the largest gaps first. the list is approximate, as the
+// solver doesn't report why it stopped: under an iteration limit every pair whose bounds didn't meet is listed, even if the solver
+// would have stopped on its own.
+std::vector<std::pair<std::size_t, std::size_t>> HGCGED::getBudgetExceededPairs() {
+	return budgetExceededPairs;
+}
+
+// returns the embedding of all graphs computed by computeApproximateGeds, one row of coordinates per graph
+std::vector<std::vector<double>> HGCGED::getEmbedding() {
+	if (!landmarkEmbedding)
+		throwError("Couldn't get embedding:", "No approximate graph edit distances computed.");
+
+	return landmarkEmbedding->getCoordinates();
+}
+
+// returns the approximate GED matrix computed by computeApproximateGeds. materializing it is quadratic in the number of graphs.
+std::vector<std::vector<double>> HGCGED::getApproximateDistanceMatrix() {
+	if (!landmarkEmbedding)
+		throwError("Couldn't get approximate distance matrix:", "No approximate graph edit distances computed.");
+
+	std::size_t numberOfGraphs = landmarkEmbedding->getCoordinates().size();
+	std::vector<std::vector<double>> approximateDistanceMatrix(numberOfGraphs, std::vector<double>(numberOfGraphs, 0));
+	for (std::size_t graphId1 = 0; graphId1 < numberOfGraphs; graphId1++) {
+		for (std::size_t graphId2 = graphId1 + 1; graphId2 < numberOfGraphs; graphId2++) {
+			double distance = landmarkEmbedding->distance(graphId1, graphId2);
+			approximateDistanceMatrix.at(graphId1).at(graphId2) = distance;
+			approximateDistanceMatrix.at(graphId2).at(graphId1) = distance;
+		}
+	}
+	return approximateDistanceMatrix;
+}
+
+// returns the node map of the given pair of the last computation. each entry is the image of a node of the first graph or -1 if it is deleted.
+std::vector<int> HGCGED::getNodeMap(ged::GEDGraph::GraphID graphId1, ged::GEDGraph::GraphID graphId2) {
+	if (nodeMaps.empty())
+		throwError("Couldn't get node map:", "Node maps are only kept when the distances only mode is disabled before computing the graph edit distances.");
+	if (graphId1 >= distanceMatrix.size() || graphId2 >= distanceMatrix.size() || (nodeMaps.at(graphId1).empty() && (graphId1 >= snapshots.size() || snapshots.at(graphId1).numberOfNodes() > 0)))
+		throwError("Couldn't get node map:", "The pair (" + std::to_string(graphId1) + ", " + std::to_string(graphId2) + ") is not contained in the last computation.");
+
+	// the node maps of a row are stored back to back, each with an image per node of the first graph
+	const std::vector<int>& rowNodeMaps = nodeMaps.at(graphId1);
+	std::size_t numberOfNodes = rowNodeMaps.size() / distanceMatrix.size();
+	return std::vector<int>(rowNodeMaps.begin() + static_cast<long>(graphId2 * numberOfNodes), rowNodeMaps.begin() + static_cast<long>((graphId2 + 1) * numberOfNodes));
+}
+
+// returns the statistics of the grouping of identical graphs of the last computation
+std::map<std::string, std::size_t> HGCGED::getDeduplicationStatistics() {
+	return deduplicationStatistics;
+}
+
+// returns the graph size statistics of the last loaded omics data before and after sparsification
+std::map<std::string, std::size_t> HGCGED::getSparsificationStatistics() {
+	return sparsificationStatistics;
+}
+
+// estimates the bytes held by each component of the environment. gedlib doesn't report the memory of its graphs, so they are
+// estimated from the number of graphs, nodes and distinct edges as "graphs_estimate". the per-pair state of the solvers is estimated
+// as well, the other components are counted from their containers. the resident and the peak resident set size of the process are
+// measured.
+std::map<std::string, std::size_t> HGCGED::getMemoryUsage() {
+	auto stringBytes = [](const std::string& string) { return sizeof(std::string) + (string.capacity() > 15 ? string.capacity() + 1 : 0); };
+	std::size_t treeNodeBytes = 4 * sizeof(void*);
+
+	std::map<std::string, std::size_t> usage;
+	usage["omics_data"] = 0;
+	for (const std::pair<const std::string, std::map<std::string, double>>& sample : sampleNamesToFeatures) {
+		usage["omics_data"] += treeNodeBytes + stringBytes(sample.first) + sizeof(sample.second);
+		for (const std::pair<const std::string, double>& feature : sample.second)
+			usage["omics_data"] += treeNodeBytes + stringBytes(feature.first) + sizeof(double);
+	}
+	usage["attributes"] = attributes.memoryUsage();
+	usage["graphs_estimate"] = ged_ ? ged_->num_graphs() * bytesPerStoredGraph + storedNodes * bytesPerStoredNode + storedEdges * bytesPerStoredEdge : 0;
+	usage["snapshots"] = 0;
+	std::size_t maximumNodes = 0;
+	for (const HGCGraphSnapshot<HGCNodeLabel, HGCEdgeLabel>& snapshot : snapshots) {
+		usage["snapshots"] += snapshot.memoryUsage();
+		maximumNodes = std::max(maximumNodes, snapshot.numberOfNodes());
+	}
+	usage["edit_costs"] = datasetEditCosts ? datasetEditCosts->memoryUsage() : 0;
+	usage["solver_contexts"] = contexts.size() * pairStateBytes(maximumNodes, contexts.empty() ? 2 : contexts.front()->numberOfSlots());
+	usage["distance_matrix"] = 0;
+	for (const std::vector<int>& row : distanceMatrix)
+		usage["distance_matrix"] += sizeof(row) + row.capacity() * sizeof(int);
+	usage["node_maps"] = 0;
+	for (const std::vector<int>& nodeMap : nodeMaps)
+		usage["node_maps"] += sizeof(nodeMap) + nodeMap.capacity() * sizeof(int);
+	usage["gap_matrix"] = 0;
+	for (const std::vector<double>& row : gapMatrix)
+		usage["gap_matrix"] += sizeof(row) + row.capacity() * sizeof(double);
+
+	std::size_t total = 0;
+	for (const std::pair<const std::string, std::size_t>& component : usage)
+		total += component.second;
+	usage["total"] = total;
+	usage["resident"] = readResidentSetSize();
+	usage["peak_resident"] = readPeakResidentSetSize();
+	return usage;
+}
+
+// returns the number of features and nodes of the last loaded omics data before and after the feature filter and the modeled speedups
+// in percent, empty without a filter
+std::map<std::string, std::size_t> HGCGED::getFeatureFilterStatistics() {
+	return featureFilterStatistics;
+}
+
+// returns how many pairs the last single linkage computation solved with the configured method and how many it avoided
+std::map<std::string, std::size_t> HGCGED::getLazyLinkageStatistics() {
+	return lazyLinkageStatistics;
+}
+
+// returns the number of pairs and settings of the last cost sweep, how many pairs it solved and how many of them were solved again
+std::map<std::string, std::size_t> HGCGED::getCostSweepStatistics() {
+	return costSweepStatistics;
+}
+
+// returns the support of each merge of the reference clustering of the last stability computation, -1 where it couldn't be estimated
+std::vector<double> HGCGED::getBootstrapSupport() {
+	return bootstrapSupport;
+}
+
+// returns how often each pair of graphs ended up in the same cluster in the last stability computation, -1 where they were never resampled together
+std::vector<std::vector<double>> HGCGED::getCoClusteringFrequencies() {
+	return coClusteringFrequencies;
+}
+
+// returns the peak memory usage in bytes that was reached during the last computation
+std::size_t HGCGED::getPeakMemoryUsage() {
+	return peakMemoryUsage;
+}
+
+// counts the labels generated for the labeled attribute per cluster, given the cluster of every graph. graphs without a value of the
+// labeled attribute are counted with an empty label.
+std::vector<std::map<std::string, std::size_t>> HGCGED::getLabelCounts(const std::vector<std::size_t>& clusters) {
+	if (clusters.size() != labelVector.size())
+		throwError("Couldn't count labels:", "Expected a cluster for each of the " + std::to_string(labelVector.size()) + " labeled graphs, got " + std::to_string(clusters.size()) + ".");
+	if (labelCodes.empty() && !labelVector.empty())
+		throwError("Couldn't count labels:", "The labels were not generated from an attribute.");
+
+	// count by code, the last code of every cluster counts the missing values
+	std::size_t numberOfClusters = clusters.empty() ? 0 : *std::max_element(clusters.begin(), clusters.end()) + 1;
+	std::size_t numberOfCodes = labelDictionary.size() + 1;
+	std::vector<std::size_t> counts(numberOfClusters * numberOfCodes, 0);
+	for (std::size_t graphId = 0; graphId < clusters.size(); graphId++) {
+		std::uint32_t code = labelCodes.at(graphId);
+		counts.at(clusters.at(graphId) * numberOfCodes + (code == HGCAttributeTable::missing ? labelDictionary.size() : code))++;
+	}
+
+	std::vector<std::map<std::string, std::size_t>> labelCounts(numberOfClusters);
+	for (std::size_t cluster = 0; cluster < numberOfClusters; cluster++) {
+		for (std::size_t code = 0; code < numberOfCodes; code++) {
+			std::size_t count = counts.at(cluster * numberOfCodes + code);
+			if (count > 0)
+				labelCounts.at(cluster).emplace(code < labelDictionary.size() ? labelDictionary.at(code) : "", count);
+		}
+	}
+	return labelCounts;
+}
+
+// returns a table of the recorded trace spans per name
+std::string HGCGED::getTraceSummary() {
+	if (computeRunning)
+		throwError("Couldn't summarize trace:", "A computation is still running.");
+	return HGCTrace::instance().summary();
+}
+
+// writes the recorded trace spans into a json file in the chrome trace event format
+void HGCGED::writeTrace(const std::string& path) {
+	if (computeRunning)
+		throwError("Couldn't write trace:", "A computation is still running.");
+	HGCTrace::instance().writeChromeTrace(path);
+}
+
 // returns the label vector
 std::vector<std::string> HGCGED::getLabelVector() {
 	return labelVector;
@@ -761,8 +2586,9 @@ std::string HGCGED::getEditCostsName() {
 	return editCostsName;
 }
 
-// returns the graph with the given id in the ged environment as a triple containing its adjacency matrix, its node labels and its edge labels
-std::vector<std::variant<std::vector<std::vector<std::size_t>>, std::vector<std::size_t>, std::map<std::pair<std::size_t, std::size_t>, double>>> HGCGED::getGraph(ged::GEDGraph::GraphID id) {
+// returns the graph with the given id in the ged environment as a triple containing its edges, its node labels and its edge labels.
+// the edges are given as a list of node pairs rather than as a dense adjacency matrix, whose size is quadratic in the number of nodes.
+std::vector<std::variant<std::vector<std::pair<std::size_t, std::size_t>>, std::vector<HGCNodeLabel>, std::map<std::pair<std::size_t, std::size_t>, HGCEdgeLabel>>> HGCGED::getGraph(ged::GEDGraph::GraphID id) {
 
 	if (!ged_)
 		throwError("Couldn't get graph:", "HGC environment not constructed.");
@@ -770,20 +2596,36 @@ std::vector<std::variant<std::vector<std::vector<std::size_t>>, std::vector<std:
 	if (id >= ged_->num_graphs())
 		throwError("Couldn't get graph:", "A graph with ID " + std::to_string(id) + " is not contained in the environment.");
 
-	ged::ExchangeGraph<std::size_t, std::size_t, double> graph = ged_->get_graph(id, true, false, false);
+	ged::ExchangeGraph<HGCNodeId, HGCNodeLabel, HGCEdgeLabel> graph = ged_->get_graph(id, false, false, true);
+
+	std::vector<std::pair<std::size_t, std::size_t>> edges;
+	std::map<std::pair<std::size_t, std::size_t>, HGCEdgeLabel> edgeLabels;
+	edges.reserve(graph.edge_list.size());
+	for (const std::pair<std::pair<std::size_t, std::size_t>, HGCEdgeLabel>& edge : graph.edge_list) {
+		edges.emplace_back(edge.first);
+		edgeLabels.emplace(edge.first, edge.second);
+	}
 
 	std::vector<std::variant<
-		std::vector<std::vector<std::size_t>>,					// adjacency matrix type
-		std::vector<std::size_t>,								// node label type
-		std::map<std::pair<std::size_t, std::size_t>, double>	// edge label type
-	>> graph_data = std::vector<std::variant<std::vector<std::vector<std::size_t>>, std::vector<std::size_t>, std::map<std::pair<std::size_t, std::size_t>, double>>>();
-	graph_data.emplace_back(graph.adj_matrix);
+		std::vector<std::pair<std::size_t, std::size_t>>,				// edge list type
+		std::vector<HGCNodeLabel>,										// node label type
+		std::map<std::pair<std::size_t, std::size_t>, HGCEdgeLabel>	// edge label type
+	>> graph_data = std::vector<std::variant<std::vector<std::pair<std::size_t, std::size_t>>, std::vector<HGCNodeLabel>, std::map<std::pair<std::size_t, std::size_t>, HGCEdgeLabel>>>();
+	graph_data.emplace_back(edges);
 	graph_data.emplace_back(graph.node_labels);
-	graph_data.emplace_back(graph.edge_labels);
+	graph_data.emplace_back(edgeLabels);
 
 	return graph_data;
 }
 
+// returns the ids of all graphs with the given name in the ged environment
+std::vector<ged::GEDGraph::GraphID> HGCGED::getGraphIds(const std::string& graphName) {
+	auto graphIds = graphNamesToGraphIds.find(graphName);
+	if (graphIds == graphNamesToGraphIds.end())
+		return {};
+	return graphIds->second;
+}
+
 // returns the name of the graph with the given id in the ged environment
 std::string HGCGED::getGraphName(ged::GEDGraph::GraphID id) {
 	if (!ged_)
@@ -806,53 +2648,199 @@ std::size_t HGCGED::getNumberOfGraphs() {
 
 #pragma region set
 
+// sets the path of a csv file into which the predicted and the measured runtimes of a sample of the solved pairs are written after each computation
+void HGCGED::setScheduleLog(const std::string& path) {
+	scheduleLogPath = path;
+}
+
+// enables or disables recording trace spans. spans are only recorded if the module was built with HGC_ENABLE_TRACING.
+void HGCGED::setTracing(bool value) {
+#ifndef HGC_ENABLE_TRACING
+	if (value)
+		showWarning("HGC was built without HGC_ENABLE_TRACING, so no trace spans will be recorded.");
+#endif
+	if (value && !HGCTrace::instance().isEnabled())
+		HGCTrace::instance().clear();
+	HGCTrace::instance().setEnabled(value);
+}
+
+// sets whether identical graphs are grouped, so that the geds are computed only once per pair of classes of identical graphs (default)
+void HGCGED::setDeduplicate(bool value) {
+	if (computeRunning)
+		throwError("Couldn't set deduplication:", "A computation is still running.");
+	deduplicate = value;
+}
+
+// sets whether multi-threaded computations with custom edit costs evaluate the costs on a single dispatch thread and memoize them
+// (default) or let every solver thread call python itself. the dispatcher requires the cost functions to be pure.
+void HGCGED::setDispatchCustomCosts(bool value) {
+	dispatchCustomCosts = value;
+}
+
+// limits the time in seconds and the number of iterations spent on each pair, 0 meaning unlimited. a pair which runs out of its budget
+// gets the best upper bound found so far, and the gap to its lower bound is recorded in the gap matrix. only applies to BRANCH_TIGHT.
+void HGCGED::setPairBudget(double seconds, std::size_t iterations) {
+	if (computeRunning)
+		throwError("Couldn't set pair budget:", "A computation is still running.");
+	if (seconds < 0)
+		throwError("Couldn't set pair budget:", "The time limit must not be negative.");
+	if ((seconds > 0 || iterations > 0) && methodName != "BRANCH_TIGHT")
+		showWarning("The pair budget only applies to the BRANCH_TIGHT method and is ignored by the " + methodName + " method.");
+	pairTimeLimit = seconds;
+	pairIterationLimit = iterations;
+}
+
+// sets the number of bytes which loading and computing may use according to getMemoryUsage, 0 meaning unlimited. operations which
+// would exceed it fail before allocating, and a computation which would only exceed it by keeping the node maps discards them instead.
+void HGCGED::setMemoryBudget(std::size_t bytes) {
+	memoryBudget = bytes;
+}
+
+// throws an error with the given message if the given number of bytes exceeds the memory budget
+void HGCGED::checkMemoryBudget(const std::string& message, std::size_t requiredBytes, const std::string& hint) {
+	if (memoryBudget > 0 && requiredBytes > memoryBudget)
+		throwError(message, "By the estimates of get_memory_usage, it would need about " + toMebibytes(requiredBytes) + ", exceeding the memory budget of " + toMebibytes(memoryBudget) + ". " + hint);
+}
+
+// estimates the bytes a solver context with the given number of slots needs for graphs with the given number of nodes: the loaded
+// graphs and the assignment problem over the nodes plus dummy nodes, whose cost matrix and solver state are both quadratic
+std::size_t HGCGED::pairStateBytes(std::size_t numberOfNodes, std::size_t numberOfSlots) {
+	std::size_t dimension = numberOfNodes + 1;
+	return numberOfSlots * (bytesPerStoredGraph + numberOfNodes * bytesPerStoredNode) + 2 * dimension * dimension * sizeof(double);
+}
+
+// sets the node factor and the insert/delete factor of the edit costs of a costs dataset, which default to 0.5. they apply to the
+// current and to subsequently loaded costs datasets.
+void HGCGED::setCostFactors(double nodeFactor, double insertDeleteFactor) {
+	if (nodeFactor < 0 || nodeFactor > 1 || insertDeleteFactor < 0 || insertDeleteFactor > 1)
+		throwError("Couldn't set cost factors:", "The factors have to lie between 0 and 1.");
+	if (computeRunning)
+		throwError("Couldn't set cost factors:", "A computation is still running.");
+	costNodeFactor = nodeFactor;
+	costInsertDeleteFactor = insertDeleteFactor;
+	if (datasetEditCosts)
+		datasetEditCosts->setFactors(nodeFactor, insertDeleteFactor);
+}
+
+// sets the filter which is applied to the features of subsequently loaded omics data before the graphs are built: the samples are
+// optionally normalized to relative abundances, features present in less than the given fraction of samples or with a lower mean
+// abundance are removed, and if topKByVariance is not 0 only that many features with the highest variance are kept
+void HGCGED::setFeatureFilter(double minimumPrevalence, double minimumMeanAbundance, std::size_t topKByVariance, bool relativeAbundance) {
+	try {
+		featureFilter.configure(minimumPrevalence, minimumMeanAbundance, topKByVariance, relativeAbundance);
+	}
+	catch (const std::runtime_error& error) {
+		throwError("Couldn't set feature filter:", error.what());
+	}
+}
+
+// sets how the sample graphs of subsequently loaded omics data are sparsified: "none" (default) keeps all edges, "top_k" keeps the
+// value most deviating edges of every node and "budget" keeps the value most deviating edges of every graph
+void HGCGED::setSparsification(const std::string& mode, std::size_t value) {
+	if (mode != "none" && mode != "top_k" && mode != "budget")
+		throwError("Couldn't set sparsification:", "Unknown mode \"" + mode + "\", expected \"none\", \"top_k\" or \"budget\".");
+	sparsificationMode = mode;
+	sparsificationValue = value;
+}
+
+// sets whether the node maps of the computed pairs are discarded (default) or kept, which requires memory quadratic in the number of graphs
+void HGCGED::setDistancesOnly(bool value) {
+	if (computeRunning)
+		throwError("Couldn't set distances only mode:", "A computation is still running.");
+	distancesOnly = value;
+}
+
 // adds an empty graph into the ged environment
 std::size_t HGCGED::addGraph(const std::string& graphName) {
 	if (!ged_)
 		throwError("Couldn't add graph:", "HGC environment not constructed.");
+	if (computeRunning)
+		throwError("Couldn't add graph:", "A computation is still running.");
 
 	// if attributes are loaded, check if the graph name is already used
-	if (!sampleNamesToAttributes.empty()) {
-		for (std::size_t graphId = 0; graphId < ged_->num_graphs(); graphId++) {
-			if (ged_->get_graph_name(graphId) == graphName) {
-				showWarning("HGC Environment already contains a graph with name \"" + graphName + "\". This might lead to unwanted behavior when associating attribute data to graphs.");
-			}
-		}
+	if (!attributes.empty() && graphNamesToGraphIds.find(graphName) != graphNamesToGraphIds.end()) {
+		showWarning("HGC Environment already contains a graph with name \"" + graphName + "\". This might lead to unwanted behavior when associating attribute data to graphs.");
 	}
 
 	ged::GEDGraph::GraphID id = ged_->add_graph(graphName, "");
+	graphNamesToGraphIds[graphName].emplace_back(id);
+	labelsOutdated = true;
 	return id;
 }
 
 // adds a node to the graph with the given id in the ged environment
-void HGCGED::addNode(ged::GEDGraph::GraphID graphID, std::size_t nodeID, std::size_t nodeLabel) {
+void HGCGED::addNode(ged::GEDGraph::GraphID graphID, HGCNodeId nodeID, HGCNodeLabel nodeLabel) {
 	if (!ged_)
 		throwError("Couldn't add node:", "HGC environment not constructed.");
+	if (computeRunning)
+		throwError("Couldn't add node:", "A computation is still running.");
 
 	ged_->add_node(graphID, nodeID, nodeLabel);
+	modifiedGraphs.insert(graphID);
+	storedNodes++;
 }
 
 // adds an edge to the graph with the given id in the ged environment
-void HGCGED::addEdge(ged::GEDGraph::GraphID graphID, std::size_t nodeIDFrom, std::size_t nodeIDTo, double edgeLabel) {
+void HGCGED::addEdge(ged::GEDGraph::GraphID graphID, HGCNodeId nodeIDFrom, HGCNodeId nodeIDTo, HGCEdgeLabel edgeLabel) {
 	if (!ged_)
 		throwError("Couldn't add edge:", "HGC environment not constructed.");
+	if (computeRunning)
+		throwError("Couldn't add edge:", "A computation is still running.");
 
+	// gedlib ignores duplicate edges, which are only uncounted once the snapshot of the graph is updated
 	ged_->add_edge(graphID, nodeIDFrom, nodeIDTo, edgeLabel, true);
+	modifiedGraphs.insert(graphID);
+	storedEdges++;
 }
 
-// reinitializes the ged environment
+// preprocesses the graphs which were added or modified since the last preprocessing. otherwise this is deferred to the next computation.
 void HGCGED::reinitGed() {
 	if (!ged_)
 		throwError("Couldn't reinitialize environment:", "HGC environment not constructed.");
+	if (computeRunning)
+		throwError("Couldn't reinitialize environment:", "A computation is still running.");
 
-	ged_->init(ged_->get_init_type());
-	ged_->init_method();
+	HGC_TRACE_SCOPE("update snapshots");
+	updateGraphSnapshots();
 }
 
 #pragma endregion
 
 #pragma endregion
 
+#pragma region handle
+
+HGCComputeHandle::HGCComputeHandle(HGCGED* hgcged):
+	hgcged{hgcged} {
+}
+
+// returns the fraction of computed pairs
+double HGCComputeHandle::progress() {
+	return hgcged->getComputeProgress();
+}
+
+// returns whether the computation has finished, either completely or because it was cancelled
+bool HGCComputeHandle::done() {
+	return !hgcged->isComputeRunning();
+}
+
+// requests the computation to stop
+void HGCComputeHandle::cancel() {
+	hgcged->cancelCompute();
+}
+
+// waits for the computation to finish
+void HGCComputeHandle::wait() {
+	hgcged->waitCompute();
+}
+
+// returns the partial GED matrix, containing -1 for rows which are not completed yet
+std::vector<std::vector<int>> HGCComputeHandle::getDistanceMatrix() {
+	return hgcged->getPartialDistanceMatrix();
+}
+
+#pragma endregion
+
 #pragma region Tests
 
 // a playgorund for tests
@@ -895,32 +2883,3 @@ void HGCGED::reinitGed() {
 }
 
 #pragma endregion
-
-PYBIND11_MODULE(HGCGED, module) {
-
-	pybind11::class_<HGCGED>(module, "HGCGED")
-			// setup
-			.def(pybind11::init<std::string&, std::string&, bool, std::string&>())
-			// csv
-			.def("load_omics_data", &HGCGED::loadOmicsData)
-			.def("load_attributes_data", &HGCGED::loadAttributesData)
-			// run
-			.def("generate_labels", &HGCGED::generateLabels)
-			.def("compute_geds", &HGCGED::computeGeds, pybind11::call_guard<pybind11::gil_scoped_release>())
-			// set
-			.def("add_graph", &HGCGED::addGraph)
-			.def("add_node", &HGCGED::addNode)
-			.def("add_edge", &HGCGED::addEdge)
-			.def("reinit_ged", &HGCGED::reinitGed)
-			// get
-			.def("get_number_of_graphs", &HGCGED::getNumberOfGraphs)
-			.def("get_graph_name", &HGCGED::getGraphName)
-			.def("get_graph", &HGCGED::getGraph)
-			.def("get_method_name", &HGCGED::getMethodName)
-			.def("get_edit_costs_name", &HGCGED::getEditCostsName)
-			.def("get_label_vector", &HGCGED::getLabelVector)
-			.def("get_distance_matrix", &HGCGED::getDistanceMatrix)
-			// other
-			.def("run_tests_external", &HGCGED::runTests, pybind11::call_guard<pybind11::gil_scoped_release>());
-
-}
@@ -6,28 +6,179 @@
 #include "include/bin.hpp"
 #include "include/csv_parser.hpp"
 
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <optional>
+#include <queue>
+#include <random>
+#include <thread>
+#include <sys/resource.h>
+
+#include <pybind11/numpy.h>
+#include <pybind11/stl.h>
+
+#include "HGCAttributeTable.hpp"
+#include "HGCBootstrap.hpp"
+#include "HGCBinPairCounts.hpp"
+#include "HGCCheckpoint.hpp"
+#include "HGCClustering.hpp"
+#include "HGCCostModel.hpp"
+#include "HGCDendrogram.hpp"
 #include "HGCCosts.hpp"
+#include "HGCFeatureFilter.hpp"
+#include "HGCLandmarkEmbedding.hpp"
+#include "HGCMappedMatrix.hpp"
+#include "HGCSolverContext.hpp"
+#include "HGCTrace.hpp"
 #include "UserDefined.hpp"
 
+// the node id and label types of the graphs. feature ids fit into 32 bits and logratios don't need double precision, so compact
+// types are used unless HGC_WIDE_LABELS is defined.
+#ifdef HGC_WIDE_LABELS
+using HGCNodeId = std::size_t;
+using HGCNodeLabel = std::size_t;
+using HGCEdgeLabel = double;
+#else
+using HGCNodeId = std::uint32_t;
+using HGCNodeLabel = std::uint32_t;
+using HGCEdgeLabel = float;
+#endif
+
+// throws an error with a given console output, defined in HGCGED.cpp
+void throwError(const std::string& message, const std::string& details);
+
+class HGCComputeHandle;
+
 class HGCGED {
 
 private:
 	// resources
-	ged::GEDEnv<std::size_t, std::size_t, double>* ged_;
-	UserDefined<std::size_t, double>* customEditCosts;
-	HGCCosts<std::size_t, double>* datasetEditCosts;
+	ged::GEDEnv<HGCNodeId, HGCNodeLabel, HGCEdgeLabel>* ged_;
+	UserDefined<HGCNodeLabel, HGCEdgeLabel>* customEditCosts;
+	HGCCosts<HGCNodeLabel, HGCEdgeLabel>* datasetEditCosts;
 
 	// csv data
 	std::map<std::string, std::map<std::string, double>> sampleNamesToFeatures;			// contains the omics data
-	std::map<std::string, std::map<std::string, std::string>> sampleNamesToAttributes;	// contains the attributes data
+	HGCAttributeTable attributes;														// contains the attributes data
+
+	// sizes of the graphs in the ged environment, which gedlib doesn't report its memory for. the edges are the distinct stored ones,
+	// corrected whenever the snapshots are updated. the bytes per graph, node and edge are estimates of gedlib's adjacency lists, label
+	// tables and id maps, not measurements.
+	std::size_t storedNodes;
+	std::size_t storedEdges;
+	static constexpr std::size_t bytesPerStoredGraph = 512;
+	static constexpr std::size_t bytesPerStoredNode = 128;
+	static constexpr std::size_t bytesPerStoredEdge = 160;
+
+	// graph names
+	std::unordered_map<std::string, std::vector<ged::GEDGraph::GraphID>> graphNamesToGraphIds;
 
 	// results
 	std::vector<std::vector<int>> distanceMatrix;
+	std::vector<std::vector<int>> nodeMaps;			// only kept if distancesOnly is false. per row, the maps to all graphs back to back, filled once the row is solved
+	std::vector<std::vector<double>> gapMatrix;		// upper minus lower bound of every pair, only filled if a pair budget is set
+	std::vector<std::pair<std::size_t, std::size_t>> budgetExceededPairs;
+	std::size_t peakMemoryUsage;
+	std::unique_ptr<HGCLandmarkEmbedding> landmarkEmbedding;
 	std::vector<std::string> labelVector;
+	std::string labelAttribute;
+	std::vector<std::uint32_t> labelCodes;			// the code of each graph's label in labelDictionary, only filled if labelAttribute is set
+	std::vector<std::string> labelDictionary;
+	bool labelsOutdated;
 
 	// info
 	std::string editCostsName;
 	std::string methodName;
+	std::string methodArguments;
+	std::size_t numberOfWorkers;
+	bool distancesOnly;
+	bool deduplicate;
+	bool dispatchCustomCosts;
+	std::string sparsificationMode;
+	std::size_t sparsificationValue;
+	std::map<std::string, std::size_t> sparsificationStatistics;
+	HGCFeatureFilter featureFilter;
+	std::map<std::string, std::size_t> featureFilterStatistics;
+	double pairTimeLimit;				// seconds per pair, 0 if unlimited
+	std::size_t pairIterationLimit;		// iterations per pair, 0 if unlimited
+	std::size_t memoryBudget;			// bytes, 0 if unlimited
+	double costNodeFactor;				// the factors of the dataset edit costs
+	double costInsertDeleteFactor;
+
+	// compute state
+	std::vector<std::unique_ptr<std::pmr::monotonic_buffer_resource>> snapshotArenas;
+	std::vector<HGCGraphSnapshot<HGCNodeLabel, HGCEdgeLabel>> snapshots;
+	std::unordered_set<std::size_t> modifiedGraphs;		// graphs whose snapshot is outdated, graphs without snapshot are not contained
+	std::vector<std::unique_ptr<HGCSolverContext<HGCNodeLabel, HGCEdgeLabel>>> contexts;
+	static constexpr std::size_t tileRows = 4;		// rows a worker solves together, loading each graph once per tile of rows and columns
+	static constexpr std::size_t tileSlots = 32;	// graphs of a tile, i.e. the rows plus a block of columns
+	std::unique_ptr<std::atomic<bool>[]> completedRows;
+	std::atomic<std::size_t> nextRow;
+	std::atomic<std::size_t> computedPairs;
+	std::atomic<bool> cancelRequested;
+	std::atomic<bool> computeRunning;
+	std::thread computeThread;
+	std::optional<bool> asyncMultiThreaded;		// the threading flag of the custom edit costs to restore after a background computation
+	std::optional<bool> requestedDistancesOnly;	// the distances only mode to restore after a computation which couldn't keep the node maps
+	std::exception_ptr computeError;
+	bool peakResettable;
+
+	// classes of identical graphs
+	std::vector<std::size_t> representatives;
+	std::vector<std::vector<std::size_t>> classMembers;
+	std::map<std::string, std::size_t> deduplicationStatistics;
+
+	// lazy clustering
+	std::map<std::string, std::size_t> lazyLinkageStatistics;
+
+	// cost sweep
+	std::map<std::string, std::size_t> costSweepStatistics;
+
+	// clustering stability
+	std::vector<double> bootstrapSupport;
+	std::vector<std::vector<double>> coClusteringFrequencies;
+
+	// scheduling
+	HGCCostModel costModel;
+	std::vector<HGCCostModel::GraphFeatures> graphFeatures;
+	std::vector<std::size_t> rowOrder;
+	std::vector<std::vector<HGCCostModel::Sample>> workerSamples;
+	std::vector<std::vector<std::pair<std::size_t, std::size_t>>> workerBudgetExceededPairs;
+	std::size_t sampleStride;
+	std::string scheduleLogPath;
+
+	// checkpoint
+	std::unique_ptr<HGCCheckpoint> checkpoint;
+	std::vector<bool> checkpointedRows;
+	std::chrono::seconds checkpointInterval;
+	std::chrono::steady_clock::time_point lastCheckpoint;
+
+	ged::EditCosts<HGCNodeLabel, HGCEdgeLabel>* getEditCosts();
+	void updateGraphSnapshots();
+	void prepareSolvers(std::size_t numberOfSlots = 2);
+	void releaseSolvers();
+	std::vector<double> solvePairs(const std::vector<std::pair<std::size_t, std::size_t>>& pairs, std::vector<double>* lowerBounds = nullptr,
+								   const std::function<void(std::size_t, const HGCSolverContext<HGCNodeLabel, HGCEdgeLabel>&)>& inspect = nullptr);
+	void callInGilScope(const std::function<void()>& function);
+	std::string solverArguments();
+	void checkMemoryBudget(const std::string& message, std::size_t requiredBytes, const std::string& hint);
+	static std::size_t pairStateBytes(std::size_t numberOfNodes, std::size_t numberOfSlots = 2);
+	bool hasPairBudget();
+	std::uint64_t computeFingerprint();
+	void beginCompute(const std::string& checkpointPath, std::size_t checkpointIntervalSeconds);
+	void runCompute();
+	void restoreDistancesOnly();
+	void summarizePairBudget();
+	void finishCompute();
+	void joinComputeThread();
+	void groupIdenticalGraphs();
+	void fanOutRow(std::size_t classId);
+	void scheduleRows();
+	void calibrateCostModel();
+	void computeRows(std::size_t worker, bool coordinating);
+	void reportCompute(bool final);
 
 public:
 	ged::Options::GEDMethod loadMethod(const std::string& methodString);
@@ -42,20 +193,86 @@ public:
 
 	void computeGedsGilScope();
 	void computeGeds();
+	void computeApproximateGedsGilScope(std::size_t numberOfLandmarks, const std::string& selection, std::size_t dimension, std::size_t seed);
+	void computeApproximateGeds(std::size_t numberOfLandmarks, const std::string& selection, std::size_t dimension, std::size_t seed);
+	std::vector<double> computeGedsPairsGilScope(const std::vector<std::pair<std::size_t, std::size_t>>& pairs);
+	std::vector<double> computeGedsPairs(const std::vector<std::pair<std::size_t, std::size_t>>& pairs);
+	std::vector<double> computeGedsBlock(const std::vector<std::size_t>& queryIds, const std::vector<std::size_t>& referenceIds);
+	void computeGedsMappedGilScope(const std::string& path);
+	void computeGedsMapped(const std::string& path);
+	std::vector<HGCClustering::Merge> computeSingleLinkageGilScope();
+	std::vector<HGCClustering::Merge> computeSingleLinkage();
+	std::vector<double> computeCostSweepGilScope(const std::vector<std::pair<double, double>>& settings, double resolveGap);
+	std::vector<double> computeCostSweep(const std::vector<std::pair<double, double>>& settings, double resolveGap);
+	void computeClusteringStability(const std::string& algorithm, const std::string& mode, std::size_t numberOfResamples, double fraction,
+									std::size_t numberOfClusters, std::size_t seed, const std::vector<std::vector<double>>& referenceLinkage);
+	void computeRowDistances(const std::int32_t* condensed, std::size_t numberOfGraphs, double* output);
+	std::vector<HGCClustering::Merge> orderLeaves(const std::vector<HGCClustering::Merge>& merges, const HGCDendrogram::DistanceFunction& distance, std::size_t exactThreshold);
+	HGCComputeHandle startCompute(const std::string& checkpointPath, std::size_t checkpointIntervalSeconds);
+	double getComputeProgress();
+	bool isComputeRunning();
+	void cancelCompute();
+	void waitCompute();
+
+	void setDistancesOnly(bool value);
+	void setDeduplicate(bool value);
+	void setDispatchCustomCosts(bool value);
+	void setPairBudget(double seconds, std::size_t iterations);
+	void setScheduleLog(const std::string& path);
+	void setSparsification(const std::string& mode, std::size_t value);
+	void setFeatureFilter(double minimumPrevalence, double minimumMeanAbundance, std::size_t topKByVariance, bool relativeAbundance);
+	void setMemoryBudget(std::size_t bytes);
+	void setCostFactors(double nodeFactor, double insertDeleteFactor);
+	void setTracing(bool value);
 
 	std::vector<std::vector<int>> getDistanceMatrix();
+	std::vector<std::vector<int>> getPartialDistanceMatrix();
+	std::vector<std::vector<double>> getGapMatrix();
+	std::vector<std::pair<std::size_t, std::size_t>> getBudgetExceededPairs();
+	std::vector<std::vector<double>> getEmbedding();
+	std::vector<std::vector<double>> getApproximateDistanceMatrix();
+	std::vector<int> getNodeMap(ged::GEDGraph::GraphID graphId1, ged::GEDGraph::GraphID graphId2);
+	std::map<std::string, std::size_t> getDeduplicationStatistics();
+	std::map<std::string, std::size_t> getSparsificationStatistics();
+	std::map<std::string, std::size_t> getFeatureFilterStatistics();
+	std::map<std::string, std::size_t> getLazyLinkageStatistics();
+	std::map<std::string, std::size_t> getCostSweepStatistics();
+	std::vector<double> getBootstrapSupport();
+	std::vector<std::vector<double>> getCoClusteringFrequencies();
+	std::size_t getPeakMemoryUsage();
+	std::map<std::string, std::size_t> getMemoryUsage();
+	std::string getTraceSummary();
+	void writeTrace(const std::string& path);
 	std::vector<std::string> getLabelVector();
+	std::vector<std::map<std::string, std::size_t>> getLabelCounts(const std::vector<std::size_t>& clusters);
 	std::string getMethodName();
 	std::string getEditCostsName();
-	std::vector<std::variant<std::vector<std::vector<std::size_t>>, std::vector<std::size_t>, std::map<std::pair<std::size_t, std::size_t>, double>>> getGraph(ged::GEDGraph::GraphID id);
+	std::vector<std::variant<std::vector<std::pair<std::size_t, std::size_t>>, std::vector<HGCNodeLabel>, std::map<std::pair<std::size_t, std::size_t>, HGCEdgeLabel>>> getGraph(ged::GEDGraph::GraphID id);
 	std::string getGraphName(ged::GEDGraph::GraphID id);
+	std::vector<ged::GEDGraph::GraphID> getGraphIds(const std::string& graphName);
 	std::size_t getNumberOfGraphs();
 	std::size_t addGraph(const std::string& graphName);
-	void addNode(ged::GEDGraph::GraphID graphID, std::size_t nodeID, std::size_t nodeLabel);
-	void addEdge(ged::GEDGraph::GraphID graphID, std::size_t nodeIDFrom, std::size_t nodeIDTo, double edgeLabel);
+	void addNode(ged::GEDGraph::GraphID graphID, HGCNodeId nodeID, HGCNodeLabel nodeLabel);
+	void addEdge(ged::GEDGraph::GraphID graphID, HGCNodeId nodeIDFrom, HGCNodeId nodeIDTo, HGCEdgeLabel edgeLabel);
 	void reinitGed();
 
 	[[maybe_unused]] void runTests();
 };
 
+// a handle to a computation started by HGCGED::startCompute, running in the background
+class HGCComputeHandle {
+
+private:
+	HGCGED* hgcged;
+
+public:
+	explicit HGCComputeHandle(HGCGED* hgcged);
+
+	double progress();
+	bool done();
+	void cancel();
+	void wait();
+	std::vector<std::vector<int>> getDistanceMatrix();
+};
+
 #endif //HGCCPP_HGCGED_H
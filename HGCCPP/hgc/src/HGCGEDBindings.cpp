@@ -0,0 +1,213 @@
+#include "HGCGED.h"
+
+// the python bindings of HGCGED, which only the python module compiles. the native executables link HGCGED.cpp without them.
+
+#pragma region helper functions
+
+// converts a linkage matrix in scipy's format into merges
+std::vector<HGCClustering::Merge> linkageToMerges(const pybind11::array_t<double, pybind11::array::c_style | pybind11::array::forcecast>& linkage) {
+	if (linkage.size() == 0)
+		return {};
+	if (linkage.ndim() != 2 || linkage.shape(1) != 4)
+		throwError("Couldn't read linkage:", "A linkage matrix has four columns.");
+	std::vector<HGCClustering::Merge> merges;
+	const double* data = linkage.data();
+	for (pybind11::ssize_t row = 0; row < linkage.shape(0); row++, data += 4)
+		merges.push_back({static_cast<std::size_t>(data[0]), static_cast<std::size_t>(data[1]), data[2], static_cast<std::size_t>(data[3])});
+	return merges;
+}
+
+// converts merges into a linkage matrix in scipy's format
+pybind11::array_t<double> mergesToLinkage(const std::vector<HGCClustering::Merge>& merges) {
+	pybind11::array_t<double> linkage({static_cast<pybind11::ssize_t>(merges.size()), static_cast<pybind11::ssize_t>(4)});
+	double* data = linkage.mutable_data();
+	for (const HGCClustering::Merge& merge : merges) {
+		*data++ = static_cast<double>(merge.cluster1);
+		*data++ = static_cast<double>(merge.cluster2);
+		*data++ = merge.distance;
+		*data++ = static_cast<double>(merge.size);
+	}
+	return linkage;
+}
+
+#pragma endregion
+
+PYBIND11_MODULE(HGCGED, module) {
+
+	pybind11::class_<HGCGED>(module, "HGCGED")
+			// setup
+			.def(pybind11::init<std::string&, std::string&, bool, std::string&>())
+			// csv
+			.def("load_omics_data", &HGCGED::loadOmicsData)
+			.def("load_attributes_data", &HGCGED::loadAttributesData)
+			// run
+			.def("generate_labels", &HGCGED::generateLabels)
+			.def("compute_geds", &HGCGED::computeGeds, pybind11::call_guard<pybind11::gil_scoped_release>())
+			.def("start_compute", &HGCGED::startCompute, pybind11::keep_alive<0, 1>())
+			.def("compute_approximate_geds", &HGCGED::computeApproximateGeds, pybind11::call_guard<pybind11::gil_scoped_release>())
+			.def("compute_geds_mapped", &HGCGED::computeGedsMapped, pybind11::call_guard<pybind11::gil_scoped_release>())
+			.def("compute_cost_sweep", [](HGCGED& hgcged, const std::vector<std::pair<double, double>>& settings, double resolveGap) {
+				std::vector<double> matrices;
+				{
+					pybind11::gil_scoped_release release;
+					matrices = hgcged.computeCostSweep(settings, resolveGap);
+				}
+				auto numberOfGraphs = static_cast<pybind11::ssize_t>(hgcged.getNumberOfGraphs());
+				return pybind11::array_t<double>({static_cast<pybind11::ssize_t>(settings.size()), numberOfGraphs, numberOfGraphs}, matrices.data());
+			}, pybind11::arg("settings"), pybind11::arg("resolve_gap") = -1.0)
+			.def("compute_clustering_stability", &HGCGED::computeClusteringStability, pybind11::call_guard<pybind11::gil_scoped_release>(),
+				 pybind11::arg("algorithm"), pybind11::arg("mode") = "bootstrap", pybind11::arg("number_of_resamples") = 100, pybind11::arg("fraction") = 0.8,
+				 pybind11::arg("number_of_clusters") = 2, pybind11::arg("seed") = 0, pybind11::arg("reference_linkage") = std::vector<std::vector<double>>())
+			.def("compute_single_linkage", [](HGCGED& hgcged) {
+				std::vector<HGCClustering::Merge> merges;
+				{
+					pybind11::gil_scoped_release release;
+					merges = hgcged.computeSingleLinkage();
+				}
+				return mergesToLinkage(merges);
+			})
+			// the euclidean distances between the rows of a condensed 32 bit ged matrix are written into a condensed double array of
+			// the same length, e.g. a mapped array, without unpacking the matrix
+			.def("compute_row_distances", [](HGCGED& hgcged, const pybind11::array_t<std::int32_t, pybind11::array::c_style>& geds,
+											 pybind11::array_t<double, pybind11::array::c_style>& output) {
+				std::size_t numberOfGraphs = static_cast<std::size_t>((1 + std::sqrt(1 + 8 * static_cast<double>(geds.size()))) / 2);
+				if (geds.ndim() != 1 || numberOfGraphs * (numberOfGraphs - 1) / 2 != static_cast<std::size_t>(geds.size()))
+					throwError("Couldn't compute row distances:", "The geds have to be a condensed distance matrix.");
+				if (output.ndim() != 1 || output.size() != geds.size())
+					throwError("Couldn't compute row distances:", "The output has to be as long as the condensed distance matrix.");
+				const std::int32_t* data = geds.data();
+				double* outputData = output.mutable_data();
+				pybind11::gil_scoped_release release;
+				hgcged.computeRowDistances(data, numberOfGraphs, outputData);
+			}, pybind11::arg("geds"), pybind11::arg("output"))
+			// a square matrix is compared by its rows like the clustering does, a condensed one is used directly. condensed 32 bit geds
+			// (e.g. a mapped distance matrix) are read in place, anything else is converted to doubles.
+			.def("order_leaves", [](HGCGED& hgcged, const pybind11::array_t<double, pybind11::array::c_style | pybind11::array::forcecast>& linkage,
+									const pybind11::array& distances, std::size_t exactThreshold) {
+				std::vector<HGCClustering::Merge> merges = linkageToMerges(linkage);
+				std::size_t numberOfLeaves = merges.size() + 1;
+				pybind11::array_t<std::int32_t, pybind11::array::c_style> geds;
+				pybind11::array_t<double, pybind11::array::c_style | pybind11::array::forcecast> values;
+				HGCDendrogram::DistanceFunction distance;
+				if (distances.ndim() == 1) {
+					if (static_cast<std::size_t>(distances.size()) != numberOfLeaves * (numberOfLeaves - 1) / 2)
+						throwError("Couldn't order leaves:", "The condensed distance matrix doesn't belong to the linkage.");
+					if (pybind11::isinstance<pybind11::array_t<std::int32_t, pybind11::array::c_style>>(distances)) {
+						geds = distances.cast<pybind11::array_t<std::int32_t, pybind11::array::c_style>>();
+						distance = [data = geds.data(), numberOfLeaves](std::size_t i, std::size_t j) {
+							return i == j ? 0.0 : static_cast<double>(data[HGCClustering::condensedIndex(numberOfLeaves, i, j)]);
+						};
+					}
+					else {
+						values = pybind11::array_t<double, pybind11::array::c_style | pybind11::array::forcecast>::ensure(distances);
+						if (!values)
+							throwError("Couldn't order leaves:", "The distances have to be numbers.");
+						distance = [data = values.data(), numberOfLeaves](std::size_t i, std::size_t j) {
+							return i == j ? 0.0 : data[HGCClustering::condensedIndex(numberOfLeaves, i, j)];
+						};
+					}
+				}
+				else {
+					values = pybind11::array_t<double, pybind11::array::c_style | pybind11::array::forcecast>::ensure(distances);
+					if (!values || values.ndim() != 2 || static_cast<std::size_t>(values.shape(0)) != numberOfLeaves)
+						throwError("Couldn't order leaves:", "The distance matrix doesn't belong to the linkage.");
+					distance = [data = values.data(), columns = static_cast<std::size_t>(values.shape(1))](std::size_t row1, std::size_t row2) {
+						double sum = 0;
+						for (std::size_t column = 0; column < columns; column++) {
+							double difference = data[row1 * columns + column] - data[row2 * columns + column];
+							sum += difference * difference;
+						}
+						return std::sqrt(sum);
+					};
+				}
+				{
+					pybind11::gil_scoped_release release;
+					merges = hgcged.orderLeaves(merges, distance, exactThreshold);
+				}
+				return mergesToLinkage(merges);
+			}, pybind11::arg("linkage"), pybind11::arg("distances"), pybind11::arg("exact_threshold") = 1000)
+			.def("compute_geds_pairs", [](HGCGED& hgcged, const std::vector<std::pair<std::size_t, std::size_t>>& pairs) {
+				std::vector<double> distances;
+				{
+					pybind11::gil_scoped_release release;
+					distances = hgcged.computeGedsPairs(pairs);
+				}
+				return pybind11::array_t<double>(static_cast<pybind11::ssize_t>(distances.size()), distances.data());
+			})
+			.def("compute_geds_block", [](HGCGED& hgcged, const std::vector<std::size_t>& queryIds, const std::vector<std::size_t>& referenceIds) {
+				std::vector<double> distances;
+				{
+					pybind11::gil_scoped_release release;
+					distances = hgcged.computeGedsBlock(queryIds, referenceIds);
+				}
+				pybind11::array_t<double> block({static_cast<pybind11::ssize_t>(queryIds.size()), static_cast<pybind11::ssize_t>(referenceIds.size())});
+				std::copy(distances.begin(), distances.end(), block.mutable_data());
+				return block;
+			})
+			// set
+			.def("add_graph", &HGCGED::addGraph)
+			.def("add_node", &HGCGED::addNode)
+			.def("add_edge", &HGCGED::addEdge)
+			.def("reinit_ged", &HGCGED::reinitGed)
+			.def("set_distances_only", &HGCGED::setDistancesOnly)
+			.def("set_deduplicate", &HGCGED::setDeduplicate)
+			.def("set_dispatch_custom_costs", &HGCGED::setDispatchCustomCosts)
+			.def("set_pair_budget", &HGCGED::setPairBudget)
+			.def("set_schedule_log", &HGCGED::setScheduleLog)
+			.def("set_sparsification", &HGCGED::setSparsification)
+			.def("set_feature_filter", &HGCGED::setFeatureFilter)
+			.def("set_memory_budget", &HGCGED::setMemoryBudget)
+			.def("set_cost_factors", &HGCGED::setCostFactors)
+			.def("set_tracing", &HGCGED::setTracing)
+			// get
+			.def("get_number_of_graphs", &HGCGED::getNumberOfGraphs)
+			.def("get_graph_name", &HGCGED::getGraphName)
+			.def("get_graph_ids", &HGCGED::getGraphIds)
+			.def("get_graph", &HGCGED::getGraph)
+			.def("get_method_name", &HGCGED::getMethodName)
+			.def("get_edit_costs_name", &HGCGED::getEditCostsName)
+			.def("get_label_vector", &HGCGED::getLabelVector)
+			.def("get_label_counts", &HGCGED::getLabelCounts)
+			.def("get_distance_matrix", &HGCGED::getDistanceMatrix)
+			.def("get_gap_matrix", &HGCGED::getGapMatrix)
+			.def("get_budget_exceeded_pairs", &HGCGED::getBudgetExceededPairs)
+			.def("get_embedding", &HGCGED::getEmbedding)
+			.def("get_approximate_distance_matrix", &HGCGED::getApproximateDistanceMatrix)
+			.def("get_node_map", &HGCGED::getNodeMap)
+			.def("get_deduplication_statistics", &HGCGED::getDeduplicationStatistics)
+			.def("get_sparsification_statistics", &HGCGED::getSparsificationStatistics)
+			.def("get_feature_filter_statistics", &HGCGED::getFeatureFilterStatistics)
+			.def("get_lazy_linkage_statistics", &HGCGED::getLazyLinkageStatistics)
+			.def("get_cost_sweep_statistics", &HGCGED::getCostSweepStatistics)
+			.def("get_bootstrap_support", &HGCGED::getBootstrapSupport)
+			.def("get_co_clustering_frequencies", &HGCGED::getCoClusteringFrequencies)
+			.def("get_peak_memory_usage", &HGCGED::getPeakMemoryUsage)
+			.def("get_memory_usage", &HGCGED::getMemoryUsage)
+			.def("get_trace_summary", &HGCGED::getTraceSummary)
+			// other
+			.def("write_trace", &HGCGED::writeTrace)
+			.def("run_tests_external", &HGCGED::runTests, pybind11::call_guard<pybind11::gil_scoped_release>());
+
+	pybind11::class_<HGCComputeHandle>(module, "HGCComputeHandle")
+			.def("progress", &HGCComputeHandle::progress)
+			.def("done", &HGCComputeHandle::done)
+			.def("cancel", &HGCComputeHandle::cancel)
+			.def("wait", &HGCComputeHandle::wait, pybind11::call_guard<pybind11::gil_scoped_release>())
+			.def("get_distance_matrix", &HGCComputeHandle::getDistanceMatrix);
+
+	// dendrogram export, which doesn't need an environment
+	module.def("dendrogram_arrays", [](const pybind11::array_t<double, pybind11::array::c_style | pybind11::array::forcecast>& linkage) {
+		std::vector<HGCClustering::Merge> merges = linkageToMerges(linkage);
+		HGCDendrogram::Arrays arrays = HGCDendrogram::toArrays(merges, merges.size() + 1);
+		auto numberOfNodes = static_cast<pybind11::ssize_t>(arrays.parents.size());
+		return pybind11::make_tuple(pybind11::array_t<long long>(numberOfNodes, arrays.parents.data()),
+									pybind11::array_t<long long>(numberOfNodes, arrays.leftChildren.data()),
+									pybind11::array_t<long long>(numberOfNodes, arrays.rightChildren.data()),
+									pybind11::array_t<double>(numberOfNodes, arrays.heights.data()));
+	}, pybind11::arg("linkage"));
+	module.def("dendrogram_newick", [](const pybind11::array_t<double, pybind11::array::c_style | pybind11::array::forcecast>& linkage, const std::vector<std::string>& names) {
+		std::vector<HGCClustering::Merge> merges = linkageToMerges(linkage);
+		return HGCDendrogram::toNewick(merges, merges.size() + 1, names);
+	}, pybind11::arg("linkage"), pybind11::arg("names") = std::vector<std::string>());
+
+}
@@ -0,0 +1,245 @@
+#include <filesystem>
+#include <iostream>
+
+#include "HGCGED.h"
+
+// runs the load, ged and clustering pipeline of main.py natively, without starting a python interpreter. only the inputs which
+// don't need python are supported, so gml datasets and custom edit costs still require main.py. writes the distance matrix, the
+// labels and the linkage matrix of the clustering (in scipy's format, with its leaves ordered like main.py does) as csv or as raw
+// little endian binary files, and the dendrogram in the newick format.
+
+namespace {
+
+const std::string usageString =
+		"Usage:\tHGCGEDExec\n"
+		"\t-out <path-to-out-directory>\n"
+		"\t-csv_omics <path-to-csv-file>\n"
+		"\t[-csv_clinical <path-to-csv-file>]\n"
+		"\t[-csv_distances <path-to-csv-file>]\n"
+		"\t[-edit_costs constant|auto]\n"
+		"\t[-label_attribute <clinical-attribute>]\n"
+		"\t[-cluster_algo nearest_point|farthest_point|upgma|wpgma|upgmc|wpgmc|incremental]\n"
+		"\t[-ged_method FAST|STANDARD|TIGHT]\n"
+		"\t[--<method-option> <method-arg>] [...]\n"
+		"\t[-init_type LAZY (EAGER is deprecated and ignored)]\n"
+		"\t[-checkpoint <path-to-checkpoint-file>]\n"
+		"\t[-edge_top_k <edges-per-node>]\n"
+		"\t[-edge_budget <edges-per-graph>]\n"
+		"\t[-min_prevalence <fraction-of-samples>]\n"
+		"\t[-min_mean_abundance <abundance>]\n"
+		"\t[-top_variance_features <features>]\n"
+		"\t[-relative_abundance yes|no]\n"
+		"\t[-memory_budget <mebibytes>]\n"
+		"\t[-exact_ordering_limit <leaves>]\n"
+		"\t[-format csv|binary]\n"
+		"Binary files contain the number of rows and columns as uint64 followed by the values row by row, as int32 for the distance\n"
+		"matrix and as float64 for the linkage matrix.";
+
+struct Arguments {
+	std::string outPath;
+	std::string csvOmicsPath;
+	std::string csvClinicalPath;
+	std::string csvDistancesPath;
+	std::string editCosts;
+	std::string labeledAttribute;
+	std::string clusterAlgorithm;
+	std::string gedMethod;
+	std::string methodArguments;
+	std::string initType;
+	std::string checkpointPath;
+	std::string sparsificationMode = "none";
+	std::size_t sparsificationValue = 0;
+	double minimumPrevalence = 0;
+	double minimumMeanAbundance = 0;
+	std::size_t topVarianceFeatures = 0;
+	bool relativeAbundance = false;
+	std::size_t memoryBudget = 0;
+	std::size_t exactOrderingLimit = 1000;
+	std::string format = "csv";
+};
+
+Arguments parseArguments(int argc, char* argv[]) {
+	if (argc < 2) {
+		std::cout << usageString << std::endl;
+		std::exit(EXIT_SUCCESS);
+	}
+
+	Arguments arguments;
+	for (int c = 1; c < argc; c++) {
+		std::string option = argv[c];
+		if (option.size() < 2 || option[0] != '-')
+			throw std::runtime_error("Argument \"" + option + "\" given but no option specified for it.\n" + usageString);
+		if (option == "-help") {
+			std::cout << usageString << std::endl;
+			std::exit(EXIT_SUCCESS);
+		}
+		if (c + 1 >= argc)
+			throw std::runtime_error("Option \"" + option.substr(1) + "\" specified but no argument given for it.\n" + usageString);
+		std::string value = argv[++c];
+
+		std::string name = option.substr(1);
+		if (name == "out")
+			arguments.outPath = value;
+		else if (name == "csv_omics")
+			arguments.csvOmicsPath = value;
+		else if (name == "csv_clinical")
+			arguments.csvClinicalPath = value;
+		else if (name == "csv_distances")
+			arguments.csvDistancesPath = value;
+		else if (name == "edit_costs")
+			arguments.editCosts = value;
+		else if (name == "label_attribute")
+			arguments.labeledAttribute = value;
+		else if (name == "cluster_algo")
+			arguments.clusterAlgorithm = value;
+		else if (name == "ged_method")
+			arguments.gedMethod = value;
+		else if (name[0] == '-')
+			arguments.methodArguments += (arguments.methodArguments.empty() ? "" : " ") + option + " " + value;
+		else if (name == "init_type")
+			arguments.initType = value;
+		else if (name == "checkpoint")
+			arguments.checkpointPath = value;
+		else if (name == "edge_top_k" || name == "edge_budget") {
+			arguments.sparsificationMode = name == "edge_top_k" ? "top_k" : "budget";
+			arguments.sparsificationValue = std::stoul(value);
+		}
+		else if (name == "min_prevalence")
+			arguments.minimumPrevalence = std::stod(value);
+		else if (name == "min_mean_abundance")
+			arguments.minimumMeanAbundance = std::stod(value);
+		else if (name == "top_variance_features")
+			arguments.topVarianceFeatures = std::stoul(value);
+		else if (name == "relative_abundance")
+			arguments.relativeAbundance = value == "yes";
+		else if (name == "memory_budget")
+			arguments.memoryBudget = std::stoul(value) * 1024 * 1024;
+		else if (name == "exact_ordering_limit")
+			arguments.exactOrderingLimit = std::stoul(value);
+		else if (name == "format")
+			arguments.format = value;
+		else if (name == "gml" || name == "gml_node_label" || name == "gml_edge_label")
+			throw std::runtime_error("GML datasets are parsed by the python interface, use main.py for them.");
+		else
+			throw std::runtime_error("Invalid option \"" + name + "\".\n" + usageString);
+	}
+
+	if (arguments.outPath.empty() || arguments.csvOmicsPath.empty())
+		throw std::runtime_error("An out directory and a CSV omics dataset must be specified.\n" + usageString);
+	if (arguments.editCosts.empty()) {
+		std::cout << "No edit costs passed. Defaulting to \"auto\"." << std::endl;
+		arguments.editCosts = "auto";
+	}
+	else if (arguments.editCosts == "custom")
+		throw std::runtime_error("Custom edit costs are python functions, use main.py for them.");
+	else if (arguments.editCosts != "constant" && arguments.editCosts != "auto")
+		throw std::runtime_error("Invalid edit_costs passed (\"" + arguments.editCosts + "\").");
+	if (arguments.format != "csv" && arguments.format != "binary")
+		throw std::runtime_error("Invalid format passed (\"" + arguments.format + "\").");
+
+	return arguments;
+}
+
+template<class T>
+void writeBinary(const std::filesystem::path& path, const std::vector<std::vector<T>>& rows) {
+	std::ofstream file(path, std::ios::binary);
+	if (!file)
+		throw std::runtime_error("Error! Couldn't open \"" + path.string() + "\".");
+	std::uint64_t dimensions[2] = {rows.size(), rows.empty() ? 0 : rows.front().size()};
+	file.write(reinterpret_cast<const char*>(dimensions), sizeof(dimensions));
+	for (const std::vector<T>& row : rows)
+		file.write(reinterpret_cast<const char*>(row.data()), static_cast<std::streamsize>(row.size() * sizeof(T)));
+}
+
+template<class T>
+void writeCsv(const std::filesystem::path& path, const std::vector<std::string>& header, const std::vector<std::string>& rowNames, const std::vector<std::vector<T>>& rows) {
+	std::ofstream file(path);
+	if (!file)
+		throw std::runtime_error("Error! Couldn't open \"" + path.string() + "\".");
+	file << std::setprecision(17);
+	for (std::size_t column = 0; column < header.size(); column++)
+		file << (column == 0 ? "" : ",") << header.at(column);
+	file << "\n";
+	for (std::size_t row = 0; row < rows.size(); row++) {
+		file << rowNames.at(row);
+		for (const T& value : rows.at(row))
+			file << "," << value;
+		file << "\n";
+	}
+}
+
+}
+
+int main(int argc, char* argv[]) {
+	try {
+		Arguments arguments = parseArguments(argc, argv);
+		std::filesystem::path outPath(arguments.outPath);
+		std::filesystem::create_directories(outPath);
+
+		// construct & load
+		HGCGED hgcged(arguments.gedMethod, arguments.methodArguments, false, arguments.initType);
+		hgcged.setMemoryBudget(arguments.memoryBudget);
+		hgcged.setSparsification(arguments.sparsificationMode, arguments.sparsificationValue);
+		hgcged.setFeatureFilter(arguments.minimumPrevalence, arguments.minimumMeanAbundance, arguments.topVarianceFeatures, arguments.relativeAbundance);
+		hgcged.loadOmicsData(arguments.csvOmicsPath, arguments.editCosts == "auto" ? arguments.csvDistancesPath : "", ',');
+		if (!arguments.csvClinicalPath.empty())
+			hgcged.loadAttributesData(arguments.csvClinicalPath, ',');
+		hgcged.generateLabels(arguments.labeledAttribute);
+
+		// ged
+		std::cout << "Calculating graph edit distances (using the " << hgcged.getMethodName() << " method with " << hgcged.getEditCostsName() << " edit costs)..." << std::endl;
+		if (arguments.checkpointPath.empty())
+			hgcged.computeGeds();
+		else
+			hgcged.startCompute(arguments.checkpointPath, 60).wait();
+		std::vector<std::vector<int>> distanceMatrix = hgcged.getDistanceMatrix();
+
+		std::vector<std::string> graphNames;
+		for (std::size_t graphId = 0; graphId < distanceMatrix.size(); graphId++)
+			graphNames.emplace_back(hgcged.getGraphName(graphId));
+		std::vector<std::string> labels = hgcged.getLabelVector();
+
+		// cluster
+		std::string algorithm = HGCClustering::parseAlgorithm(arguments.clusterAlgorithm);
+		std::cout << "Generating clustering (using the " << algorithm << " method)..." << std::endl;
+		std::size_t numberOfThreads = std::max(std::thread::hardware_concurrency(), 1u);
+		std::vector<HGCClustering::Merge> merges = HGCClustering::linkage(HGCClustering::rowDistances(distanceMatrix, numberOfThreads), distanceMatrix.size(), algorithm);
+		merges = hgcged.orderLeaves(merges, HGCDendrogram::rowDistance(distanceMatrix), arguments.exactOrderingLimit);
+		std::vector<std::vector<double>> linkageMatrix;
+		for (const HGCClustering::Merge& merge : merges)
+			linkageMatrix.push_back({static_cast<double>(merge.cluster1), static_cast<double>(merge.cluster2), merge.distance, static_cast<double>(merge.size)});
+
+		// save
+		std::string filename = algorithm + "_" + hgcged.getMethodName();
+		if (arguments.format == "binary") {
+			writeBinary(outPath / "distance_matrix.bin", distanceMatrix);
+			writeBinary(outPath / (filename + "_linkage.bin"), linkageMatrix);
+		}
+		else {
+			std::vector<std::string> header = {"graph"};
+			header.insert(header.end(), graphNames.begin(), graphNames.end());
+			writeCsv(outPath / "distance_matrix.csv", header, graphNames, distanceMatrix);
+			std::vector<std::string> mergeNames;
+			for (std::size_t merge = 0; merge < merges.size(); merge++)
+				mergeNames.emplace_back(std::to_string(distanceMatrix.size() + merge));
+			writeCsv(outPath / (filename + "_linkage.csv"), {"cluster", "cluster1", "cluster2", "distance", "size"}, mergeNames, linkageMatrix);
+		}
+		std::ofstream newick(outPath / (filename + ".nwk"));
+		if (!newick)
+			throw std::runtime_error("Error! Couldn't open \"" + (outPath / (filename + ".nwk")).string() + "\".");
+		newick << HGCDendrogram::toNewick(merges, distanceMatrix.size(), graphNames) << "\n";
+		if (labels.size() == graphNames.size()) {
+			std::vector<std::vector<std::string>> labelRows;
+			for (const std::string& label : labels)
+				labelRows.push_back({label});
+			writeCsv(outPath / "labels.csv", {"graph", "label"}, graphNames, labelRows);
+		}
+
+		std::cout << "Done! Results written to \"" << outPath.string() << "\"." << std::endl;
+	}
+	catch (const std::exception& exception) {
+		std::cerr << exception.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,171 @@
+#ifndef SRC_HGC_GRAPH_SNAPSHOT_HPP_
+#define SRC_HGC_GRAPH_SNAPSHOT_HPP_
+
+#include <cstdint>
+#include <limits>
+#include <memory_resource>
+#include <tuple>
+
+#include "HGCCheckpoint.hpp"
+
+// a read-only copy of a graph of the ged environment from which the solver contexts load their pairs. the edges are stored in
+// compressed sparse row form with 32 bit node ids, each edge once at its smaller node: the edges of node u are edgeTargets and
+// edgeLabels in [edgeOffsets[u], edgeOffsets[u + 1]).
+template<class UserNodeLabel, class UserEdgeLabel>
+struct HGCGraphSnapshot {
+
+	explicit HGCGraphSnapshot(std::pmr::memory_resource* resource);
+
+	void assign(const std::vector<UserNodeLabel>& labels, const std::vector<std::pair<std::pair<std::size_t, std::size_t>, UserEdgeLabel>>& edgeList);
+	void computeCanonicalHash();
+	bool isIdentical(const HGCGraphSnapshot<UserNodeLabel, UserEdgeLabel>& other) const;
+
+	std::size_t numberOfNodes() const;
+	std::size_t numberOfEdges() const;
+	std::vector<std::size_t> degrees() const;
+	std::size_t memoryUsage() const;
+
+	std::pmr::vector<UserNodeLabel> nodeLabels;
+	std::pmr::vector<std::uint32_t> edgeOffsets;
+	std::pmr::vector<std::uint32_t> edgeTargets;
+	std::pmr::vector<UserEdgeLabel> edgeLabels;
+
+	// a hash that does not depend on the order of the nodes and edges. it identifies a graph up to isomorphism only if its node labels
+	// are unique, as they are for sample graphs whose node labels are feature ids.
+	std::uint64_t canonicalHash;
+	bool hasUniqueNodeLabels;
+
+private:
+	std::pair<std::vector<UserNodeLabel>, std::vector<std::tuple<UserNodeLabel, UserNodeLabel, UserEdgeLabel>>> canonicalForm() const;
+
+};
+
+#ifndef SRC_HGC_GRAPH_SNAPSHOT_IPP_
+#define SRC_HGC_GRAPH_SNAPSHOT_IPP_
+
+template<class UserNodeLabel, class UserEdgeLabel>
+HGCGraphSnapshot<UserNodeLabel, UserEdgeLabel>::
+HGCGraphSnapshot(std::pmr::memory_resource* resource):
+	nodeLabels{resource},
+	edgeOffsets{resource},
+	edgeTargets{resource},
+	edgeLabels{resource},
+	canonicalHash{0},
+	hasUniqueNodeLabels{false} {
+}
+
+// fills the snapshot with the given node labels and the given edges, which are given by the internal ids of their nodes
+template<class UserNodeLabel, class UserEdgeLabel>
+void
+HGCGraphSnapshot<UserNodeLabel, UserEdgeLabel>::
+assign(const std::vector<UserNodeLabel>& labels, const std::vector<std::pair<std::pair<std::size_t, std::size_t>, UserEdgeLabel>>& edgeList) {
+	if (labels.size() > std::numeric_limits<std::uint32_t>::max() || edgeList.size() > std::numeric_limits<std::uint32_t>::max())
+		throw std::length_error("Error! Graph too large for a snapshot with 32 bit node ids.");
+
+	nodeLabels.assign(labels.begin(), labels.end());
+
+	// counting sort of the edges by their smaller node
+	edgeOffsets.assign(labels.size() + 1, 0);
+	for (const std::pair<std::pair<std::size_t, std::size_t>, UserEdgeLabel>& edge : edgeList)
+		edgeOffsets[std::min(edge.first.first, edge.first.second) + 1]++;
+	for (std::size_t nodeId = 0; nodeId < labels.size(); nodeId++)
+		edgeOffsets[nodeId + 1] += edgeOffsets[nodeId];
+
+	std::vector<std::uint32_t> positions(edgeOffsets.begin(), edgeOffsets.end() - 1);
+	edgeTargets.resize(edgeList.size());
+	edgeLabels.resize(edgeList.size());
+	for (const std::pair<std::pair<std::size_t, std::size_t>, UserEdgeLabel>& edge : edgeList) {
+		std::uint32_t& position = positions.at(std::min(edge.first.first, edge.first.second));
+		edgeTargets[position] = static_cast<std::uint32_t>(std::max(edge.first.first, edge.first.second));
+		edgeLabels[position] = edge.second;
+		position++;
+	}
+}
+
+// computes the canonical hash of the graph. has to be called after the graph is complete.
+template<class UserNodeLabel, class UserEdgeLabel>
+void
+HGCGraphSnapshot<UserNodeLabel, UserEdgeLabel>::
+computeCanonicalHash() {
+	auto [sortedNodeLabels, sortedEdges] = canonicalForm();
+	hasUniqueNodeLabels = std::adjacent_find(sortedNodeLabels.begin(), sortedNodeLabels.end()) == sortedNodeLabels.end();
+
+	canonicalHash = HGCCheckpoint::hash(sortedNodeLabels.data(), sortedNodeLabels.size() * sizeof(UserNodeLabel));
+	for (const std::tuple<UserNodeLabel, UserNodeLabel, UserEdgeLabel>& edge : sortedEdges) {
+		canonicalHash = HGCCheckpoint::hash(&std::get<0>(edge), sizeof(UserNodeLabel), canonicalHash);
+		canonicalHash = HGCCheckpoint::hash(&std::get<1>(edge), sizeof(UserNodeLabel), canonicalHash);
+		canonicalHash = HGCCheckpoint::hash(&std::get<2>(edge), sizeof(UserEdgeLabel), canonicalHash);
+	}
+}
+
+// checks whether both graphs are identical up to the order of their nodes. only reliable if both have unique node labels.
+template<class UserNodeLabel, class UserEdgeLabel>
+bool
+HGCGraphSnapshot<UserNodeLabel, UserEdgeLabel>::
+isIdentical(const HGCGraphSnapshot<UserNodeLabel, UserEdgeLabel>& other) const {
+	if (canonicalHash != other.canonicalHash || nodeLabels.size() != other.nodeLabels.size() || edgeTargets.size() != other.edgeTargets.size())
+		return false;
+	return canonicalForm() == other.canonicalForm();
+}
+
+// returns the sorted node labels and the sorted edges, each given by the labels of its nodes and its own label
+template<class UserNodeLabel, class UserEdgeLabel>
+std::pair<std::vector<UserNodeLabel>, std::vector<std::tuple<UserNodeLabel, UserNodeLabel, UserEdgeLabel>>>
+HGCGraphSnapshot<UserNodeLabel, UserEdgeLabel>::
+canonicalForm() const {
+	std::vector<UserNodeLabel> sortedNodeLabels(nodeLabels.begin(), nodeLabels.end());
+	std::sort(sortedNodeLabels.begin(), sortedNodeLabels.end());
+
+	std::vector<std::tuple<UserNodeLabel, UserNodeLabel, UserEdgeLabel>> sortedEdges;
+	sortedEdges.reserve(edgeTargets.size());
+	for (std::size_t nodeId = 0; nodeId < nodeLabels.size(); nodeId++) {
+		for (std::uint32_t edgeId = edgeOffsets[nodeId]; edgeId < edgeOffsets[nodeId + 1]; edgeId++) {
+			const UserNodeLabel& label1 = nodeLabels[nodeId];
+			const UserNodeLabel& label2 = nodeLabels[edgeTargets[edgeId]];
+			sortedEdges.emplace_back(std::min(label1, label2), std::max(label1, label2), edgeLabels[edgeId]);
+		}
+	}
+	std::sort(sortedEdges.begin(), sortedEdges.end());
+
+	return {sortedNodeLabels, sortedEdges};
+}
+
+template<class UserNodeLabel, class UserEdgeLabel>
+std::size_t
+HGCGraphSnapshot<UserNodeLabel, UserEdgeLabel>::
+numberOfNodes() const {
+	return nodeLabels.size();
+}
+
+template<class UserNodeLabel, class UserEdgeLabel>
+std::size_t
+HGCGraphSnapshot<UserNodeLabel, UserEdgeLabel>::
+numberOfEdges() const {
+	return edgeTargets.size();
+}
+
+// returns the bytes of the node and edge arrays, which are allocated from the arena of the snapshot
+template<class UserNodeLabel, class UserEdgeLabel>
+std::size_t
+HGCGraphSnapshot<UserNodeLabel, UserEdgeLabel>::
+memoryUsage() const {
+	return sizeof(*this) + nodeLabels.capacity() * sizeof(UserNodeLabel) + (edgeOffsets.capacity() + edgeTargets.capacity()) * sizeof(std::uint32_t) + edgeLabels.capacity() * sizeof(UserEdgeLabel);
+}
+
+// returns the degree of every node
+template<class UserNodeLabel, class UserEdgeLabel>
+std::vector<std::size_t>
+HGCGraphSnapshot<UserNodeLabel, UserEdgeLabel>::
+degrees() const {
+	std::vector<std::size_t> nodeDegrees(nodeLabels.size(), 0);
+	for (std::size_t nodeId = 0; nodeId < nodeLabels.size(); nodeId++) {
+		nodeDegrees.at(nodeId) += edgeOffsets[nodeId + 1] - edgeOffsets[nodeId];
+		for (std::uint32_t edgeId = edgeOffsets[nodeId]; edgeId < edgeOffsets[nodeId + 1]; edgeId++)
+			nodeDegrees.at(edgeTargets[edgeId])++;
+	}
+	return nodeDegrees;
+}
+
+#endif /* SRC_HGC_GRAPH_SNAPSHOT_IPP_ */
+
+#endif /* SRC_HGC_GRAPH_SNAPSHOT_HPP_ */
@@ -0,0 +1,213 @@
+#ifndef SRC_HGC_LANDMARK_EMBEDDING_HPP_
+#define SRC_HGC_LANDMARK_EMBEDDING_HPP_
+
+#include <cmath>
+#include <numeric>
+
+// embeds all graphs into a euclidean space using landmark mds (a nyström approximation of classical mds), given only the distances
+// between a small set of landmark graphs and all graphs. a dimension of 0 uses as many dimensions as the landmarks support. the
+// approximate distance of two graphs is the euclidean distance of their embeddings, clamped into the bounds the landmarks imply by
+// the triangle inequality.
+class HGCLandmarkEmbedding {
+
+public:
+	HGCLandmarkEmbedding(const std::vector<std::size_t>& landmarks, const std::vector<std::vector<double>>& landmarkDistances, std::size_t dimension);
+	virtual ~HGCLandmarkEmbedding();
+
+	double distance(std::size_t graphId1, std::size_t graphId2) const;
+	double lowerBound(std::size_t graphId1, std::size_t graphId2) const;
+	double upperBound(std::size_t graphId1, std::size_t graphId2) const;
+
+	const std::vector<std::vector<double>>& getCoordinates() const;
+	std::size_t getDimension() const;
+
+private:
+	static void eigenDecomposition(std::vector<std::vector<double>>& matrix, std::vector<double>& eigenvalues, std::vector<std::vector<double>>& eigenvectors);
+
+	std::vector<std::size_t> landmarks;
+	std::vector<std::vector<double>> landmarkDistances;		// landmarkDistances[l][g] is the distance between landmark l and graph g
+	std::vector<std::vector<double>> coordinates;
+
+};
+
+#ifndef SRC_HGC_LANDMARK_EMBEDDING_IPP_
+#define SRC_HGC_LANDMARK_EMBEDDING_IPP_
+
+inline
+HGCLandmarkEmbedding::
+HGCLandmarkEmbedding(const std::vector<std::size_t>& landmarks, const std::vector<std::vector<double>>& landmarkDistances, std::size_t dimension):
+	landmarks{landmarks},
+	landmarkDistances{landmarkDistances} {
+
+	std::size_t numberOfLandmarks = landmarks.size();
+	std::size_t numberOfGraphs = landmarkDistances.empty() ? 0 : landmarkDistances.front().size();
+
+	// squared distances between the landmarks, made symmetric
+	std::vector<std::vector<double>> squaredDistances(numberOfLandmarks, std::vector<double>(numberOfLandmarks, 0));
+	for (std::size_t i = 0; i < numberOfLandmarks; i++) {
+		for (std::size_t j = 0; j < numberOfLandmarks; j++) {
+			double distance = std::min(landmarkDistances.at(i).at(landmarks.at(j)), landmarkDistances.at(j).at(landmarks.at(i)));
+			squaredDistances.at(i).at(j) = distance * distance;
+		}
+	}
+
+	// double centering
+	std::vector<double> means(numberOfLandmarks, 0);
+	double totalMean = 0;
+	for (std::size_t i = 0; i < numberOfLandmarks; i++) {
+		for (std::size_t j = 0; j < numberOfLandmarks; j++)
+			means.at(i) += squaredDistances.at(i).at(j);
+		means.at(i) /= static_cast<double>(numberOfLandmarks);
+		totalMean += means.at(i);
+	}
+	totalMean /= static_cast<double>(numberOfLandmarks);
+	std::vector<std::vector<double>> centered(numberOfLandmarks, std::vector<double>(numberOfLandmarks, 0));
+	for (std::size_t i = 0; i < numberOfLandmarks; i++) {
+		for (std::size_t j = 0; j < numberOfLandmarks; j++)
+			centered.at(i).at(j) = -0.5 * (squaredDistances.at(i).at(j) - means.at(i) - means.at(j) + totalMean);
+	}
+
+	// keep the largest positive eigenpairs
+	std::vector<double> eigenvalues;
+	std::vector<std::vector<double>> eigenvectors;
+	eigenDecomposition(centered, eigenvalues, eigenvectors);
+	std::vector<std::size_t> order(numberOfLandmarks);
+	std::iota(order.begin(), order.end(), 0);
+	std::sort(order.begin(), order.end(), [&eigenvalues](std::size_t a, std::size_t b) { return eigenvalues.at(a) > eigenvalues.at(b); });
+	std::vector<std::size_t> components;
+	for (std::size_t index : order) {
+		if ((dimension != 0 && components.size() == dimension) || eigenvalues.at(index) <= 1e-9)
+			break;
+		components.emplace_back(index);
+	}
+
+	// triangulate every graph from its squared distances to the landmarks
+	coordinates = std::vector<std::vector<double>>(numberOfGraphs, std::vector<double>(components.size(), 0));
+	for (std::size_t graphId = 0; graphId < numberOfGraphs; graphId++) {
+		for (std::size_t component = 0; component < components.size(); component++) {
+			std::size_t index = components.at(component);
+			double projection = 0;
+			for (std::size_t landmark = 0; landmark < numberOfLandmarks; landmark++) {
+				double distance = landmarkDistances.at(landmark).at(graphId);
+				projection += eigenvectors.at(landmark).at(index) * (distance * distance - means.at(landmark));
+			}
+			coordinates.at(graphId).at(component) = -0.5 * projection / std::sqrt(eigenvalues.at(index));
+		}
+	}
+}
+
+inline
+HGCLandmarkEmbedding::
+~HGCLandmarkEmbedding() = default;
+
+// returns the approximate distance of two graphs
+inline
+double
+HGCLandmarkEmbedding::
+distance(std::size_t graphId1, std::size_t graphId2) const {
+	if (graphId1 == graphId2)
+		return 0;
+
+	double squaredDistance = 0;
+	for (std::size_t component = 0; component < coordinates.at(graphId1).size(); component++) {
+		double difference = coordinates.at(graphId1).at(component) - coordinates.at(graphId2).at(component);
+		squaredDistance += difference * difference;
+	}
+	return std::clamp(std::sqrt(squaredDistance), lowerBound(graphId1, graphId2), upperBound(graphId1, graphId2));
+}
+
+// returns the largest lower bound on the distance of two graphs that follows from the triangle inequality over all landmarks
+inline
+double
+HGCLandmarkEmbedding::
+lowerBound(std::size_t graphId1, std::size_t graphId2) const {
+	double bound = 0;
+	for (const std::vector<double>& distances : landmarkDistances)
+		bound = std::max(bound, std::fabs(distances.at(graphId1) - distances.at(graphId2)));
+	return bound;
+}
+
+// returns the smallest upper bound on the distance of two graphs that follows from the triangle inequality over all landmarks
+inline
+double
+HGCLandmarkEmbedding::
+upperBound(std::size_t graphId1, std::size_t graphId2) const {
+	double bound = std::numeric_limits<double>::infinity();
+	for (const std::vector<double>& distances : landmarkDistances)
+		bound = std::min(bound, distances.at(graphId1) + distances.at(graphId2));
+	return bound;
+}
+
+inline
+const std::vector<std::vector<double>>&
+HGCLandmarkEmbedding::
+getCoordinates() const {
+	return coordinates;
+}
+
+inline
+std::size_t
+HGCLandmarkEmbedding::
+getDimension() const {
+	return coordinates.empty() ? 0 : coordinates.front().size();
+}
+
+// computes all eigenvalues and eigenvectors (as columns) of a symmetric matrix using the cyclic jacobi method. the matrix is destroyed.
+inline
+void
+HGCLandmarkEmbedding::
+eigenDecomposition(std::vector<std::vector<double>>& matrix, std::vector<double>& eigenvalues, std::vector<std::vector<double>>& eigenvectors) {
+	std::size_t size = matrix.size();
+	eigenvectors = std::vector<std::vector<double>>(size, std::vector<double>(size, 0));
+	for (std::size_t i = 0; i < size; i++)
+		eigenvectors.at(i).at(i) = 1;
+
+	for (int sweep = 0; sweep < 100; sweep++) {
+		double offDiagonal = 0;
+		for (std::size_t p = 0; p < size; p++) {
+			for (std::size_t q = p + 1; q < size; q++)
+				offDiagonal += matrix.at(p).at(q) * matrix.at(p).at(q);
+		}
+		if (offDiagonal < 1e-18)
+			break;
+
+		for (std::size_t p = 0; p < size; p++) {
+			for (std::size_t q = p + 1; q < size; q++) {
+				if (std::fabs(matrix.at(p).at(q)) < 1e-300)
+					continue;
+
+				double theta = (matrix.at(q).at(q) - matrix.at(p).at(p)) / (2 * matrix.at(p).at(q));
+				double t = (theta >= 0 ? 1.0 : -1.0) / (std::fabs(theta) + std::sqrt(theta * theta + 1));
+				double c = 1 / std::sqrt(t * t + 1);
+				double s = t * c;
+
+				for (std::size_t k = 0; k < size; k++) {
+					double kp = matrix.at(k).at(p);
+					double kq = matrix.at(k).at(q);
+					matrix.at(k).at(p) = c * kp - s * kq;
+					matrix.at(k).at(q) = s * kp + c * kq;
+				}
+				for (std::size_t k = 0; k < size; k++) {
+					double pk = matrix.at(p).at(k);
+					double qk = matrix.at(q).at(k);
+					matrix.at(p).at(k) = c * pk - s * qk;
+					matrix.at(q).at(k) = s * pk + c * qk;
+				}
+				for (std::size_t k = 0; k < size; k++) {
+					double kp = eigenvectors.at(k).at(p);
+					double kq = eigenvectors.at(k).at(q);
+					eigenvectors.at(k).at(p) = c * kp - s * kq;
+					eigenvectors.at(k).at(q) = s * kp + c * kq;
+				}
+			}
+		}
+	}
+
+	eigenvalues = std::vector<double>(size);
+	for (std::size_t i = 0; i < size; i++)
+		eigenvalues.at(i) = matrix.at(i).at(i);
+}
+
+#endif /* SRC_HGC_LANDMARK_EMBEDDING_IPP_ */
+
+#endif /* SRC_HGC_LANDMARK_EMBEDDING_HPP_ */
@@ -0,0 +1,131 @@
+#ifndef SRC_HGC_MAPPED_MATRIX_HPP_
+#define SRC_HGC_MAPPED_MATRIX_HPP_
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+// a condensed ged matrix in a memory-mapped file, for cohorts whose full matrix doesn't fit into memory. the file starts with a
+// 64 byte header followed by the int32 distances of all pairs i < j in the row-major order of scipy's condensed matrices, so it can
+// be opened with numpy.memmap(path, dtype='<i4', mode='r', offset=64) and passed to scipy's linkage directly. the complete flag in
+// the header is only set once all pairs are written.
+class HGCMappedMatrix {
+
+public:
+	struct Header {
+		char magic[8];
+		std::uint64_t numberOfGraphs;
+		std::uint64_t dataOffset;
+		char dataType[8];
+		std::uint64_t fingerprint;
+		std::uint64_t complete;
+		std::uint64_t reserved[2];
+	};
+
+	static_assert(sizeof(Header) == 64, "The header of mapped matrices has to be 64 bytes.");
+
+	HGCMappedMatrix(const std::string& path, std::size_t numberOfGraphs, std::uint64_t fingerprint);
+	virtual ~HGCMappedMatrix();
+
+	// the file descriptor and the mapping are owned by exactly one matrix
+	HGCMappedMatrix(const HGCMappedMatrix&) = delete;
+	HGCMappedMatrix& operator=(const HGCMappedMatrix&) = delete;
+
+	void set(std::size_t graphId1, std::size_t graphId2, int distance);
+	void markComplete();
+
+	static std::size_t condensedIndex(std::size_t numberOfGraphs, std::size_t graphId1, std::size_t graphId2);
+
+private:
+	std::string path;
+	std::size_t numberOfGraphs;
+	std::size_t fileSize;
+	int fileDescriptor;
+	void* mapping;
+	std::int32_t* distances;
+
+	static constexpr char magic[8] = {'H', 'G', 'C', 'D', 'M', 'A', 'T', '1'};
+
+};
+
+#ifndef SRC_HGC_MAPPED_MATRIX_IPP_
+#define SRC_HGC_MAPPED_MATRIX_IPP_
+
+// creates or truncates the file and maps it. the distances are zero until they are set.
+inline
+HGCMappedMatrix::
+HGCMappedMatrix(const std::string& path, std::size_t numberOfGraphs, std::uint64_t fingerprint):
+	path{path},
+	numberOfGraphs{numberOfGraphs},
+	fileSize{sizeof(Header) + (numberOfGraphs < 2 ? 0 : numberOfGraphs * (numberOfGraphs - 1) / 2) * sizeof(std::int32_t)},
+	fileDescriptor{-1},
+	mapping{nullptr},
+	distances{nullptr} {
+	fileDescriptor = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+	if (fileDescriptor < 0)
+		throw std::runtime_error("Error! Couldn't open distance matrix file \"" + path + "\".");
+	if (::ftruncate(fileDescriptor, static_cast<off_t>(fileSize)) != 0) {
+		::close(fileDescriptor);
+		throw std::runtime_error("Error! Couldn't allocate " + std::to_string(fileSize) + " bytes for distance matrix file \"" + path + "\".");
+	}
+	mapping = ::mmap(nullptr, fileSize, PROT_READ | PROT_WRITE, MAP_SHARED, fileDescriptor, 0);
+	if (mapping == MAP_FAILED) {
+		::close(fileDescriptor);
+		throw std::runtime_error("Error! Couldn't map distance matrix file \"" + path + "\".");
+	}
+
+	Header header{};
+	std::memcpy(header.magic, magic, sizeof(magic));
+	header.numberOfGraphs = numberOfGraphs;
+	header.dataOffset = sizeof(Header);
+	std::memcpy(header.dataType, "<i4", 4);
+	header.fingerprint = fingerprint;
+	header.complete = 0;
+	std::memcpy(mapping, &header, sizeof(Header));
+	distances = reinterpret_cast<std::int32_t*>(static_cast<char*>(mapping) + sizeof(Header));
+}
+
+// writes the mapped pages back and unmaps the file, which stays on disk
+inline
+HGCMappedMatrix::
+~HGCMappedMatrix() {
+	::msync(mapping, fileSize, MS_SYNC);
+	::munmap(mapping, fileSize);
+	::close(fileDescriptor);
+}
+
+inline
+std::size_t
+HGCMappedMatrix::
+condensedIndex(std::size_t numberOfGraphs, std::size_t graphId1, std::size_t graphId2) {
+	if (graphId1 > graphId2)
+		std::swap(graphId1, graphId2);
+	return numberOfGraphs * graphId1 - graphId1 * (graphId1 + 1) / 2 + graphId2 - graphId1 - 1;
+}
+
+// sets the distance of a pair of different graphs. different pairs may be set concurrently.
+inline
+void
+HGCMappedMatrix::
+set(std::size_t graphId1, std::size_t graphId2, int distance) {
+	distances[condensedIndex(numberOfGraphs, graphId1, graphId2)] = distance;
+}
+
+// flushes the distances and only then sets the complete flag, so a file with the flag set never contains unwritten pairs
+inline
+void
+HGCMappedMatrix::
+markComplete() {
+	::msync(mapping, fileSize, MS_SYNC);
+	static_cast<Header*>(mapping)->complete = 1;
+	::msync(mapping, sizeof(Header), MS_SYNC);
+}
+
+#endif /* SRC_HGC_MAPPED_MATRIX_IPP_ */
+
+#endif /* SRC_HGC_MAPPED_MATRIX_HPP_ */
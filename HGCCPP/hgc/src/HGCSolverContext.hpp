@@ -0,0 +1,232 @@
+#ifndef SRC_HGC_SOLVER_CONTEXT_HPP_
+#define SRC_HGC_SOLVER_CONTEXT_HPP_
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "HGCGraphSnapshot.hpp"
+#include "HGCTrace.hpp"
+
+// a reusable solver owned by exactly one worker thread. it holds its own ged environment with a fixed number of slots, into which
+// the graphs of the current pairs are loaded, so that neither the graphs nor the results of the solved pairs pile up in a shared
+// environment. a whole tile of graphs can be loaded and initialized at once, so that the pairs among them are solved without
+// reloading a graph or initializing the environment again.
+template<class UserNodeLabel, class UserEdgeLabel>
+class HGCSolverContext {
+
+public:
+	HGCSolverContext(ged::EditCosts<UserNodeLabel, UserEdgeLabel>* editCosts, ged::Options::GEDMethod method, const std::string& methodArguments,
+					 std::size_t numberOfSlots = 2);
+	virtual ~HGCSolverContext();
+
+	void load(const std::vector<std::size_t>& graphIds, const std::vector<HGCGraphSnapshot<UserNodeLabel, UserEdgeLabel>>& graphs);
+	double run(std::size_t graphId1, const HGCGraphSnapshot<UserNodeLabel, UserEdgeLabel>& graph1, std::size_t graphId2, const HGCGraphSnapshot<UserNodeLabel, UserEdgeLabel>& graph2);
+	double getLowerBound() const;
+	double getSolveSeconds() const;
+	std::vector<int> getNodeMap() const;
+	std::size_t numberOfSlots() const;
+
+private:
+	static constexpr std::size_t emptySlot = std::numeric_limits<std::size_t>::max();
+
+	std::size_t slotOf(std::size_t graphId) const;
+	std::size_t evictableSlot(std::size_t keptSlot);
+	void replace(std::size_t slot, std::size_t graphId, const HGCGraphSnapshot<UserNodeLabel, UserEdgeLabel>& graph);
+	void initialize();
+
+	ged::GEDEnv<std::size_t, UserNodeLabel, UserEdgeLabel> ged;
+	std::vector<std::size_t> loadedGraphIds;	// graph id per slot
+	std::size_t nextEviction;
+	ged::GEDGraph::GraphID solvedSlots[2];		// the slots of the last solved pair
+	bool initialized;
+	double solveSeconds;
+
+};
+
+#ifndef SRC_HGC_SOLVER_CONTEXT_IPP_
+#define SRC_HGC_SOLVER_CONTEXT_IPP_
+
+template<class UserNodeLabel, class UserEdgeLabel>
+HGCSolverContext<UserNodeLabel, UserEdgeLabel>::
+HGCSolverContext(ged::EditCosts<UserNodeLabel, UserEdgeLabel>* editCosts, ged::Options::GEDMethod method, const std::string& methodArguments,
+				 std::size_t numberOfSlots):
+	loadedGraphIds(std::max(numberOfSlots, static_cast<std::size_t>(2)), emptySlot),
+	nextEviction{0},
+	solvedSlots{0, 1},
+	initialized{false},
+	solveSeconds{0} {
+
+	if (editCosts)
+		ged.set_edit_costs(editCosts);
+	else
+		ged.set_edit_costs(ged::Options::EditCosts::CONSTANT);
+
+	for (std::size_t slot = 0; slot < loadedGraphIds.size(); slot++)
+		ged.add_graph("slot_" + std::to_string(slot));
+	ged.set_method(method, methodArguments);
+}
+
+template<class UserNodeLabel, class UserEdgeLabel>
+HGCSolverContext<UserNodeLabel, UserEdgeLabel>::
+~HGCSolverContext() = default;
+
+// loads the given graphs into the slots and initializes the environment once, keeping the slots which already hold one of them.
+// the pairs among the graphs are then solved by run without any reload.
+template<class UserNodeLabel, class UserEdgeLabel>
+void
+HGCSolverContext<UserNodeLabel, UserEdgeLabel>::
+load(const std::vector<std::size_t>& graphIds, const std::vector<HGCGraphSnapshot<UserNodeLabel, UserEdgeLabel>>& graphs) {
+	HGC_TRACE_SCOPE("load");
+	std::vector<bool> kept(loadedGraphIds.size(), false);
+	std::vector<std::size_t> missingGraphIds;
+	for (std::size_t graphId : graphIds) {
+		std::size_t slot = slotOf(graphId);
+		if (slot != emptySlot)
+			kept.at(slot) = true;
+		else if (std::find(missingGraphIds.begin(), missingGraphIds.end(), graphId) == missingGraphIds.end())
+			missingGraphIds.emplace_back(graphId);
+	}
+	if (static_cast<std::size_t>(std::count(kept.begin(), kept.end(), true)) + missingGraphIds.size() > loadedGraphIds.size())
+		throw std::runtime_error("The solver context has " + std::to_string(loadedGraphIds.size()) + " slots, which can't hold the " + std::to_string(graphIds.size()) + " graphs.");
+
+	std::size_t slot = 0;
+	for (std::size_t graphId : missingGraphIds) {
+		while (kept.at(slot))
+			slot++;
+		replace(slot, graphId, graphs.at(graphId));
+		kept.at(slot) = true;
+	}
+	initialize();
+}
+
+// solves the given pair and returns its upper bound. graphs which aren't loaded yet replace the graph of another slot.
+template<class UserNodeLabel, class UserEdgeLabel>
+double
+HGCSolverContext<UserNodeLabel, UserEdgeLabel>::
+run(std::size_t graphId1, const HGCGraphSnapshot<UserNodeLabel, UserEdgeLabel>& graph1, std::size_t graphId2, const HGCGraphSnapshot<UserNodeLabel, UserEdgeLabel>& graph2) {
+	std::size_t slot1 = slotOf(graphId1);
+	std::size_t slot2 = slotOf(graphId2);
+	if (slot1 == emptySlot || slot2 == emptySlot) {
+		HGC_TRACE_SCOPE("load");
+		if (slot1 == emptySlot) {
+			slot1 = evictableSlot(slot2);
+			replace(slot1, graphId1, graph1);
+		}
+		if (slot2 == emptySlot) {
+			slot2 = evictableSlot(slot1);
+			replace(slot2, graphId2, graph2);
+		}
+	}
+	initialize();
+
+	HGC_TRACE_SCOPE("run_method");
+	solvedSlots[0] = slot1;
+	solvedSlots[1] = slot2;
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	ged.run_method(slot1, slot2);
+	solveSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	return ged.get_upper_bound(slot1, slot2);
+}
+
+// returns the lower bound of the last solved pair, which is 0 for methods that don't compute one
+template<class UserNodeLabel, class UserEdgeLabel>
+double
+HGCSolverContext<UserNodeLabel, UserEdgeLabel>::
+getLowerBound() const {
+	return ged.get_lower_bound(solvedSlots[0], solvedSlots[1]);
+}
+
+// returns the seconds the method spent on the last solved pair, without loading the graphs and initializing the environment
+template<class UserNodeLabel, class UserEdgeLabel>
+double
+HGCSolverContext<UserNodeLabel, UserEdgeLabel>::
+getSolveSeconds() const {
+	return solveSeconds;
+}
+
+// returns the node map of the last solved pair as a compact vector, containing the image of each node of the first graph or -1 if it is deleted
+template<class UserNodeLabel, class UserEdgeLabel>
+std::vector<int>
+HGCSolverContext<UserNodeLabel, UserEdgeLabel>::
+getNodeMap() const {
+	const ged::NodeMap& nodeMap = ged.get_node_map(solvedSlots[0], solvedSlots[1]);
+	std::vector<int> images(nodeMap.num_source_nodes(), -1);
+	for (ged::GEDGraph::NodeID nodeId = 0; nodeId < nodeMap.num_source_nodes(); nodeId++) {
+		ged::GEDGraph::NodeID image = nodeMap.image(nodeId);
+		if (image != ged::GEDGraph::dummy_node() && image != ged::GEDGraph::undefined_node())
+			images.at(nodeId) = static_cast<int>(image);
+	}
+	return images;
+}
+
+template<class UserNodeLabel, class UserEdgeLabel>
+std::size_t
+HGCSolverContext<UserNodeLabel, UserEdgeLabel>::
+numberOfSlots() const {
+	return loadedGraphIds.size();
+}
+
+// returns the slot holding the given graph, or emptySlot if it isn't loaded
+template<class UserNodeLabel, class UserEdgeLabel>
+std::size_t
+HGCSolverContext<UserNodeLabel, UserEdgeLabel>::
+slotOf(std::size_t graphId) const {
+	for (std::size_t slot = 0; slot < loadedGraphIds.size(); slot++) {
+		if (loadedGraphIds[slot] == graphId)
+			return slot;
+	}
+	return emptySlot;
+}
+
+// returns the next slot in round robin order other than the given one
+template<class UserNodeLabel, class UserEdgeLabel>
+std::size_t
+HGCSolverContext<UserNodeLabel, UserEdgeLabel>::
+evictableSlot(std::size_t keptSlot) {
+	std::size_t slot = nextEviction++ % loadedGraphIds.size();
+	if (slot == keptSlot)
+		slot = nextEviction++ % loadedGraphIds.size();
+	return slot;
+}
+
+// replaces the content of the given slot with the given graph. the environment has to be initialized again afterwards.
+template<class UserNodeLabel, class UserEdgeLabel>
+void
+HGCSolverContext<UserNodeLabel, UserEdgeLabel>::
+replace(std::size_t slot, std::size_t graphId, const HGCGraphSnapshot<UserNodeLabel, UserEdgeLabel>& graph) {
+	ged.clear_graph(slot);
+	for (std::size_t nodeId = 0; nodeId < graph.nodeLabels.size(); nodeId++)
+		ged.add_node(slot, nodeId, graph.nodeLabels[nodeId]);
+	for (std::size_t nodeId = 0; nodeId < graph.nodeLabels.size(); nodeId++) {
+		for (std::uint32_t edgeId = graph.edgeOffsets[nodeId]; edgeId < graph.edgeOffsets[nodeId + 1]; edgeId++)
+			ged.add_edge(slot, nodeId, graph.edgeTargets[edgeId], graph.edgeLabels[edgeId]);
+	}
+
+	loadedGraphIds.at(slot) = graphId;
+	initialized = false;
+}
+
+// initializes the environment after graphs were replaced. the slots are initialized lazily, as eagerly precomputing all costs would
+// have to be repeated on every reload.
+template<class UserNodeLabel, class UserEdgeLabel>
+void
+HGCSolverContext<UserNodeLabel, UserEdgeLabel>::
+initialize() {
+	if (initialized)
+		return;
+	HGC_TRACE_BEGIN(initSpan, "init");
+	ged.init(ged::Options::InitType::LAZY_WITHOUT_SHUFFLED_COPIES);
+	HGC_TRACE_END(initSpan);
+	HGC_TRACE_BEGIN(initMethodSpan, "init_method");
+	ged.init_method();
+	HGC_TRACE_END(initMethodSpan);
+	initialized = true;
+}
+
+#endif /* SRC_HGC_SOLVER_CONTEXT_IPP_ */
+
+#endif /* SRC_HGC_SOLVER_CONTEXT_HPP_ */
@@ -0,0 +1,253 @@
+#ifndef SRC_HGC_TRACE_HPP_
+#define SRC_HGC_TRACE_HPP_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <unordered_map>
+
+// records named time spans of the hot paths. spans are only compiled in if HGC_ENABLE_TRACING is defined and only recorded while
+// tracing is enabled at runtime. every thread records into its own buffer, so recording never locks. the buffers are read when the
+// trace is written, which must not happen while spans are being recorded.
+class HGCTrace {
+
+public:
+	using Clock = std::chrono::steady_clock;
+
+	static HGCTrace& instance();
+
+	void setEnabled(bool value);
+	bool isEnabled() const;
+	void record(const char* name, Clock::time_point start, Clock::time_point end);
+	void clear();
+
+	void writeChromeTrace(const std::string& path) const;
+	std::string summary() const;
+
+private:
+	struct Event {
+		const char* name;
+		std::int64_t start;		// in nanoseconds since the epoch of the trace
+		std::int64_t duration;
+	};
+
+	struct Statistics {
+		std::size_t count;
+		std::int64_t total;
+		std::int64_t maximum;
+	};
+
+	// events beyond the limit are only counted in the statistics, so that tracing millions of pairs doesn't exhaust the memory
+	struct Buffer {
+		std::size_t threadId;
+		std::vector<Event> events;
+		std::unordered_map<const char*, Statistics> statistics;
+	};
+
+	HGCTrace();
+
+	Buffer& threadBuffer();
+
+	static constexpr std::size_t maximumEventsPerThread = 1 << 20;
+
+	std::atomic<bool> enabled;
+	Clock::time_point epoch;
+	mutable std::mutex buffersMutex;
+	std::vector<std::unique_ptr<Buffer>> buffers;
+
+};
+
+// records the time from its construction until end() is called or it is destroyed
+class HGCTraceSpan {
+
+public:
+	explicit HGCTraceSpan(const char* name);
+	~HGCTraceSpan();
+
+	void end();
+
+private:
+	const char* name;
+	HGCTrace::Clock::time_point start;
+	bool running;
+
+};
+
+#ifdef HGC_ENABLE_TRACING
+#define HGC_TRACE_CONCAT_INNER(a, b) a##b
+#define HGC_TRACE_CONCAT(a, b) HGC_TRACE_CONCAT_INNER(a, b)
+#define HGC_TRACE_SCOPE(name) HGCTraceSpan HGC_TRACE_CONCAT(traceSpan, __LINE__){name}
+#define HGC_TRACE_BEGIN(span, name) HGCTraceSpan span{name}
+#define HGC_TRACE_END(span) span.end()
+#else
+#define HGC_TRACE_SCOPE(name) ((void) 0)
+#define HGC_TRACE_BEGIN(span, name) ((void) 0)
+#define HGC_TRACE_END(span) ((void) 0)
+#endif
+
+#ifndef SRC_HGC_TRACE_IPP_
+#define SRC_HGC_TRACE_IPP_
+
+inline
+HGCTrace::
+HGCTrace():
+	enabled{false},
+	epoch{Clock::now()} {
+}
+
+inline
+HGCTrace&
+HGCTrace::
+instance() {
+	static HGCTrace trace;
+	return trace;
+}
+
+inline
+void
+HGCTrace::
+setEnabled(bool value) {
+	enabled = value;
+}
+
+inline
+bool
+HGCTrace::
+isEnabled() const {
+	return enabled;
+}
+
+// returns the buffer of the calling thread, registering it on the first call
+inline
+HGCTrace::Buffer&
+HGCTrace::
+threadBuffer() {
+	thread_local Buffer* buffer = nullptr;
+	if (!buffer) {
+		std::lock_guard<std::mutex> lock(buffersMutex);
+		buffers.emplace_back(std::make_unique<Buffer>());
+		buffer = buffers.back().get();
+		buffer->threadId = buffers.size();
+	}
+	return *buffer;
+}
+
+inline
+void
+HGCTrace::
+record(const char* name, Clock::time_point start, Clock::time_point end) {
+	if (!enabled)
+		return;
+
+	Buffer& buffer = threadBuffer();
+	std::int64_t duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+	if (buffer.events.size() < maximumEventsPerThread)
+		buffer.events.push_back({name, std::chrono::duration_cast<std::chrono::nanoseconds>(start - epoch).count(), duration});
+
+	Statistics& statistics = buffer.statistics[name];
+	statistics.count++;
+	statistics.total += duration;
+	statistics.maximum = std::max(statistics.maximum, duration);
+}
+
+// discards all recorded spans. the buffers themselves are kept, as the threads which own them may still be alive.
+inline
+void
+HGCTrace::
+clear() {
+	std::lock_guard<std::mutex> lock(buffersMutex);
+	for (const std::unique_ptr<Buffer>& buffer : buffers) {
+		buffer->events.clear();
+		buffer->statistics.clear();
+	}
+	epoch = Clock::now();
+}
+
+// writes the recorded spans in the chrome trace event format, which can be opened in chrome://tracing or perfetto
+inline
+void
+HGCTrace::
+writeChromeTrace(const std::string& path) const {
+	std::ofstream file(path);
+	if (!file)
+		throw std::runtime_error("Error! Couldn't open trace file \"" + path + "\".");
+
+	std::lock_guard<std::mutex> lock(buffersMutex);
+	file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+	bool first = true;
+	file << std::fixed << std::setprecision(3);
+	for (const std::unique_ptr<Buffer>& buffer : buffers) {
+		for (const Event& event : buffer->events) {
+			file << (first ? "\n" : ",\n") << "{\"name\":\"" << event.name << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->threadId
+				 << ",\"ts\":" << static_cast<double>(event.start) / 1000 << ",\"dur\":" << static_cast<double>(event.duration) / 1000 << "}";
+			first = false;
+		}
+	}
+	file << "\n]}\n";
+}
+
+// returns a table of the count, total, mean and maximum duration of every span name over all threads, sorted by total duration
+inline
+std::string
+HGCTrace::
+summary() const {
+	std::map<std::string, Statistics> merged;
+	{
+		std::lock_guard<std::mutex> lock(buffersMutex);
+		for (const std::unique_ptr<Buffer>& buffer : buffers) {
+			for (const auto& [name, statistics] : buffer->statistics) {
+				Statistics& target = merged.emplace(name, Statistics{0, 0, 0}).first->second;
+				target.count += statistics.count;
+				target.total += statistics.total;
+				target.maximum = std::max(target.maximum, statistics.maximum);
+			}
+		}
+	}
+
+	std::vector<std::pair<std::string, Statistics>> rows(merged.begin(), merged.end());
+	std::sort(rows.begin(), rows.end(), [](const auto& a, const auto& b) { return a.second.total > b.second.total; });
+
+	std::ostringstream table;
+	table << std::left << std::setw(32) << "span" << std::right << std::setw(12) << "count" << std::setw(14) << "total [ms]" << std::setw(14) << "mean [ms]" << std::setw(14) << "max [ms]" << "\n";
+	table << std::fixed << std::setprecision(3);
+	for (const auto& [name, statistics] : rows) {
+		double total = static_cast<double>(statistics.total) / 1e6;
+		table << std::left << std::setw(32) << name << std::right << std::setw(12) << statistics.count << std::setw(14) << total
+			  << std::setw(14) << total / static_cast<double>(statistics.count) << std::setw(14) << static_cast<double>(statistics.maximum) / 1e6 << "\n";
+	}
+	return table.str();
+}
+
+inline
+HGCTraceSpan::
+HGCTraceSpan(const char* name):
+	name{name},
+	start{HGCTrace::Clock::now()},
+	running{true} {
+}
+
+inline
+HGCTraceSpan::
+~HGCTraceSpan() {
+	end();
+}
+
+inline
+void
+HGCTraceSpan::
+end() {
+	if (running) {
+		HGCTrace::instance().record(name, start, HGCTrace::Clock::now());
+		running = false;
+	}
+}
+
+#endif /* SRC_HGC_TRACE_IPP_ */
+
+#endif /* SRC_HGC_TRACE_HPP_ */
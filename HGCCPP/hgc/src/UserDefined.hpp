@@ -3,6 +3,8 @@
 
 #include <pybind11/embed.h>
 
+#include "HGCCostDispatcher.hpp"
+
 template<class UserNodeLabel, class UserEdgeLabel>
 class UserDefined : public ged::EditCosts<UserNodeLabel, UserEdgeLabel> {
 
@@ -17,10 +19,14 @@ public:
 	virtual double edge_del_cost_fun(const UserEdgeLabel& edge_label) const final;
 	virtual double edge_rel_cost_fun(const UserEdgeLabel& edge_label_1, const UserEdgeLabel& edge_label_2) const final;
 
+	void startDispatcher(std::size_t memoCapacity);
+	std::size_t stopDispatcher();
+
 	bool multiThreaded;
 
 private:
 	pybind11::module pythonModule;
+	std::unique_ptr<HGCCostDispatcher<UserNodeLabel, UserEdgeLabel>> dispatcher;	// only set while multi-threaded solvers run
 
 };
 
@@ -38,12 +44,35 @@ template<class UserNodeLabel, class UserEdgeLabel>
 UserDefined<UserNodeLabel, UserEdgeLabel>::
 ~UserDefined() = default;
 
+// routes the cost calls of all threads through a dispatcher until stopDispatcher is called. must be called without holding the GIL.
+template<class UserNodeLabel, class UserEdgeLabel>
+void
+UserDefined<UserNodeLabel, UserEdgeLabel>::
+startDispatcher(std::size_t memoCapacity) {
+	dispatcher = std::make_unique<HGCCostDispatcher<UserNodeLabel, UserEdgeLabel>>(pythonModule, memoCapacity);
+}
+
+// stops the dispatcher and returns the number of cost calls it evaluated in python, which is 0 if no dispatcher was running
+template<class UserNodeLabel, class UserEdgeLabel>
+std::size_t
+UserDefined<UserNodeLabel, UserEdgeLabel>::
+stopDispatcher() {
+	if (!dispatcher)
+		return 0;
+	std::size_t numberOfPythonCalls = dispatcher->getNumberOfPythonCalls();
+	dispatcher.reset();
+	return numberOfPythonCalls;
+}
+
 template<class UserNodeLabel, class UserEdgeLabel>
 double
 UserDefined<UserNodeLabel, UserEdgeLabel>::
 node_ins_cost_fun(const UserNodeLabel& node_label) const {
 	//std::cout << "Called node_ins_cost_fun constructor" << std::endl;
 
+	if (dispatcher)
+		return dispatcher->nodeCost(HGCCostDispatcher<UserNodeLabel, UserEdgeLabel>::NODE_INS, node_label, node_label);
+
 	double result;
 	if (multiThreaded) {
 		pybind11::gil_scoped_acquire acquire;
@@ -63,6 +92,9 @@ UserDefined<UserNodeLabel, UserEdgeLabel>::
 node_del_cost_fun(const UserNodeLabel& node_label) const {
 	//std::cout << "Called UserDefined node_del_cost_fun" << std::endl;
 
+	if (dispatcher)
+		return dispatcher->nodeCost(HGCCostDispatcher<UserNodeLabel, UserEdgeLabel>::NODE_DEL, node_label, node_label);
+
 	double result;
 	if (multiThreaded) {
 		pybind11::gil_scoped_acquire acquire;
@@ -82,6 +114,9 @@ UserDefined<UserNodeLabel, UserEdgeLabel>::
 node_rel_cost_fun(const UserNodeLabel& node_label_1, const UserNodeLabel& node_label_2) const {
 	//std::cout << "Called UserDefined node_rel_cost_fun" << std::endl;
 
+	if (dispatcher)
+		return dispatcher->nodeCost(HGCCostDispatcher<UserNodeLabel, UserEdgeLabel>::NODE_REL, node_label_1, node_label_2);
+
 	double result;
 	if (multiThreaded) {
 		pybind11::gil_scoped_acquire acquire;
@@ -101,6 +136,9 @@ UserDefined<UserNodeLabel, UserEdgeLabel>::
 edge_ins_cost_fun(const UserEdgeLabel& edge_label) const {
 	//std::cout << "Called UserDefined edge_ins_cost_fun" << std::endl;
 
+	if (dispatcher)
+		return dispatcher->edgeCost(HGCCostDispatcher<UserNodeLabel, UserEdgeLabel>::EDGE_INS, edge_label, edge_label);
+
 	double result;
 	if (multiThreaded) {
 		pybind11::gil_scoped_acquire acquire;
@@ -120,6 +158,9 @@ UserDefined<UserNodeLabel, UserEdgeLabel>::
 edge_del_cost_fun(const UserEdgeLabel& edge_label) const {
 	//std::cout << "Called UserDefined edge_del_cost_fun" << std::endl;
 
+	if (dispatcher)
+		return dispatcher->edgeCost(HGCCostDispatcher<UserNodeLabel, UserEdgeLabel>::EDGE_DEL, edge_label, edge_label);
+
 	double result;
 	if (multiThreaded) {
 		pybind11::gil_scoped_acquire acquire;
@@ -139,6 +180,9 @@ UserDefined<UserNodeLabel, UserEdgeLabel>::
 edge_rel_cost_fun(const UserEdgeLabel& edge_label_1, const UserEdgeLabel& edge_label_2) const {
 	//std::cout << "Called UserDefined edge_rel_cost_fun" << std::endl;
 
+	if (dispatcher)
+		return dispatcher->edgeCost(HGCCostDispatcher<UserNodeLabel, UserEdgeLabel>::EDGE_REL, edge_label_1, edge_label_2);
+
 	double result;
 	if (multiThreaded) {
 		pybind11::gil_scoped_acquire acquire;
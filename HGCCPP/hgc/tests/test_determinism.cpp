@@ -0,0 +1,470 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <random>
+#include <thread>
+
+#include "HGCGED.h"
+
+// checks that the parallel compute paths return the same GED matrices for every method and number of threads, and that tiny graphs
+// get the distances expected from gedlib's constant edit costs (node insertion and deletion 4, node relabeling 2, edge insertion,
+// deletion and relabeling 1). the background computation, the mapped matrix, the single linkage and the cost sweep are checked
+// against the matrix in memory, and the bootstrap support and the leaf ordering against results known by construction or brute
+// force. runs without python and without data files: the omics dataset and its costs are generated from a fixed seed.
+// usage: TestDeterminism [maximum number of threads]
+
+namespace {
+
+std::size_t failures = 0;
+
+void check(bool condition, const std::string& message) {
+	if (!condition) {
+		std::cout << "FAILED: " << message << std::endl;
+		failures++;
+	}
+}
+
+// writes a dataset of samples whose features are drawn around a few seeded profiles, so that the graphs differ but are not random noise.
+// the last numberOfDuplicates samples repeat the first ones exactly, so that deduplication finds classes of identical graphs.
+std::string writeSyntheticDataset(std::size_t numberOfSamples, std::size_t numberOfFeatures, std::size_t numberOfDuplicates, std::uint32_t seed) {
+	std::mt19937 generator(seed);
+	std::lognormal_distribution<double> profileDistribution(0.0, 1.0);
+	std::normal_distribution<double> noiseDistribution(0.0, 0.25);
+
+	std::vector<std::vector<double>> profiles(3, std::vector<double>(numberOfFeatures));
+	for (std::vector<double>& profile : profiles) {
+		for (double& value : profile)
+			value = profileDistribution(generator);
+	}
+
+	std::string path = (std::filesystem::temp_directory_path() / ("hgc_determinism_" + std::to_string(seed) + ".csv")).string();
+	std::ofstream file(path);
+	file << "sample";
+	for (std::size_t feature = 0; feature < numberOfFeatures; feature++)
+		file << ",feature_" << feature;
+	file << "\n" << std::setprecision(17);
+	std::vector<std::vector<double>> samples;
+	for (std::size_t sample = 0; sample < numberOfSamples; sample++) {
+		const std::vector<double>& profile = profiles.at(sample % profiles.size());
+		samples.emplace_back();
+		for (std::size_t feature = 0; feature < numberOfFeatures; feature++)
+			samples.back().emplace_back(std::max(profile.at(feature) * std::exp(noiseDistribution(generator)), 0.0));
+	}
+	for (std::size_t duplicate = 0; duplicate < numberOfDuplicates; duplicate++)
+		samples.push_back(samples.at(duplicate));
+	for (std::size_t sample = 0; sample < samples.size(); sample++) {
+		file << "sample_" << sample;
+		for (double value : samples.at(sample))
+			file << "," << value;
+		file << "\n";
+	}
+	return path;
+}
+
+std::vector<std::vector<int>> computeMatrix(const std::string& method, std::size_t threads, const std::string& datasetPath, bool deduplicate, double& seconds,
+											std::map<std::string, std::size_t>* deduplicationStatistics = nullptr) {
+	HGCGED hgcged(method, "--threads " + std::to_string(threads), false, "LAZY");
+	hgcged.setDeduplicate(deduplicate);
+	hgcged.loadOmicsData(datasetPath, "", ',');
+
+	auto start = std::chrono::steady_clock::now();
+	hgcged.computeGeds();
+	seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	if (deduplicationStatistics)
+		*deduplicationStatistics = hgcged.getDeduplicationStatistics();
+	return hgcged.getDistanceMatrix();
+}
+
+void testHandCheckedGraphs(const std::string& method) {
+	HGCGED hgcged(method, "--threads 2", false, "LAZY");
+
+	std::size_t single = hgcged.addGraph("single");
+	hgcged.addNode(single, 0, 1);
+
+	std::size_t empty = hgcged.addGraph("empty");
+
+	std::size_t edge = hgcged.addGraph("edge");
+	hgcged.addNode(edge, 0, 1);
+	hgcged.addNode(edge, 1, 2);
+	hgcged.addEdge(edge, 0, 1, 0.5f);
+
+	std::size_t noEdge = hgcged.addGraph("no edge");
+	hgcged.addNode(noEdge, 0, 1);
+	hgcged.addNode(noEdge, 1, 2);
+
+	std::size_t relabeled = hgcged.addGraph("relabeled");
+	hgcged.addNode(relabeled, 0, 1);
+	hgcged.addNode(relabeled, 1, 3);
+	hgcged.addEdge(relabeled, 0, 1, 0.5f);
+
+	hgcged.computeGeds();
+	std::vector<std::vector<int>> matrix = hgcged.getDistanceMatrix();
+
+	check(matrix.at(single).at(empty) == 4, method + ": deleting a node costs 4");
+	check(matrix.at(edge).at(noEdge) == 1, method + ": deleting an edge costs 1");
+	check(matrix.at(edge).at(relabeled) == 2, method + ": relabeling a node costs 2");
+	for (std::size_t row = 0; row < matrix.size(); row++) {
+		check(matrix.at(row).at(row) == 0, method + ": a graph has distance 0 to itself");
+		for (std::size_t column = 0; column < matrix.size(); column++)
+			check(matrix.at(row).at(column) == matrix.at(column).at(row), method + ": the distances of the hand checked graphs are symmetric");
+	}
+
+	// the pair list path has to agree with the matrix path
+	std::vector<std::pair<std::size_t, std::size_t>> pairs = {{single, empty}, {edge, noEdge}, {edge, relabeled}, {relabeled, edge}};
+	std::vector<double> distances = hgcged.computeGedsPairs(pairs);
+	for (std::size_t index = 0; index < pairs.size(); index++)
+		check(static_cast<int>(distances.at(index)) == matrix.at(pairs.at(index).first).at(pairs.at(index).second), method + ": pair list and matrix agree");
+}
+
+// the same graph is added twice with its nodes in a different order, so that deduplication has to match it by its node labels
+void testDeduplicatedGraphs(const std::string& method) {
+	std::vector<std::vector<int>> matrices[2];
+	for (bool deduplicate : {false, true}) {
+		HGCGED hgcged(method, "--threads 2", false, "LAZY");
+		hgcged.setDeduplicate(deduplicate);
+
+		std::size_t original = hgcged.addGraph("original");
+		hgcged.addNode(original, 0, 1);
+		hgcged.addNode(original, 1, 2);
+		hgcged.addNode(original, 2, 3);
+		hgcged.addEdge(original, 0, 1, 0.5f);
+		hgcged.addEdge(original, 1, 2, 0.25f);
+
+		std::size_t other = hgcged.addGraph("other");
+		hgcged.addNode(other, 0, 1);
+		hgcged.addNode(other, 1, 4);
+		hgcged.addEdge(other, 0, 1, 0.5f);
+
+		std::size_t permuted = hgcged.addGraph("permuted");
+		hgcged.addNode(permuted, 0, 3);
+		hgcged.addNode(permuted, 1, 1);
+		hgcged.addNode(permuted, 2, 2);
+		hgcged.addEdge(permuted, 1, 2, 0.5f);
+		hgcged.addEdge(permuted, 2, 0, 0.25f);
+
+		hgcged.computeGeds();
+		matrices[deduplicate ? 1 : 0] = hgcged.getDistanceMatrix();
+		std::vector<std::vector<int>>& matrix = matrices[deduplicate ? 1 : 0];
+		if (deduplicate) {
+			std::map<std::string, std::size_t> statistics = hgcged.getDeduplicationStatistics();
+			check(statistics.at("classes") == 2, method + ": the permuted graph is deduplicated");
+		}
+		check(matrix.at(original).at(permuted) == 0 && matrix.at(permuted).at(original) == 0, method + ": the permuted graph has distance 0 to the original");
+		check(matrix.at(permuted).at(other) == matrix.at(original).at(other) && matrix.at(other).at(permuted) == matrix.at(other).at(original),
+			  method + ": the permuted graph gets the row and column of the original");
+	}
+	check(matrices[0] == matrices[1], method + ": deduplicating the permuted graph returns the matrix without deduplication");
+}
+
+void testDeterminism(const std::string& method, std::size_t maximumThreads, const std::string& datasetPath, std::size_t numberOfSamples, std::size_t numberOfDuplicates) {
+	double seconds;
+	std::vector<std::vector<int>> reference = computeMatrix(method, 1, datasetPath, false, seconds);
+	std::cout << std::left << std::setw(14) << method << std::setw(10) << 1 << std::setw(14) << "no" << std::fixed << std::setprecision(3) << seconds << std::endl;
+
+	for (std::size_t row = 0; row < reference.size(); row++)
+		check(reference.at(row).at(row) == 0, method + ": a graph has distance 0 to itself");
+
+	for (std::size_t threads = 1; threads <= maximumThreads; threads++) {
+		for (bool deduplicate : {false, true}) {
+			if (threads == 1 && !deduplicate)
+				continue;
+			std::map<std::string, std::size_t> statistics;
+			std::vector<std::vector<int>> matrix = computeMatrix(method, threads, datasetPath, deduplicate, seconds, &statistics);
+			std::cout << std::left << std::setw(14) << method << std::setw(10) << threads << std::setw(14) << (deduplicate ? "yes" : "no") << seconds << std::endl;
+			check(matrix == reference, method + " with " + std::to_string(threads) + " threads" + (deduplicate ? " and deduplication" : "") + " returns the single threaded matrix");
+			if (!deduplicate)
+				continue;
+
+			// the duplicated samples form classes with their originals and receive their rows and columns
+			check(statistics.at("classes") == numberOfSamples, method + ": the duplicated samples are deduplicated");
+			for (std::size_t duplicate = 0; duplicate < numberOfDuplicates; duplicate++) {
+				std::size_t member = numberOfSamples + duplicate;
+				check(matrix.at(member).at(duplicate) == 0, method + ": a duplicated sample has distance 0 to its original");
+				for (std::size_t column = 0; column < matrix.size(); column++) {
+					if (column != member && column != duplicate)
+						check(matrix.at(member).at(column) == matrix.at(duplicate).at(column) && matrix.at(column).at(member) == matrix.at(column).at(duplicate),
+							  method + ": a duplicated sample gets the row and column of its original");
+				}
+			}
+		}
+	}
+}
+
+// the lazy single linkage has to merge at the same heights as the single linkage over the full matrix, as it only skips edges
+// which can't be in the minimum spanning tree
+void testSingleLinkage(const std::string& method, const std::string& datasetPath) {
+	HGCGED hgcged(method, "--threads 2", false, "LAZY");
+	hgcged.loadOmicsData(datasetPath, "", ',');
+	hgcged.computeGeds();
+	std::vector<std::vector<int>> matrix = hgcged.getDistanceMatrix();
+	std::vector<double> condensed;
+	for (std::size_t graphId1 = 0; graphId1 < matrix.size(); graphId1++) {
+		for (std::size_t graphId2 = graphId1 + 1; graphId2 < matrix.size(); graphId2++)
+			condensed.emplace_back(matrix.at(graphId1).at(graphId2));
+	}
+	std::vector<HGCClustering::Merge> reference = HGCClustering::linkage(condensed, matrix.size(), "single");
+	std::vector<HGCClustering::Merge> merges = hgcged.computeSingleLinkage();
+
+	auto heights = [](const std::vector<HGCClustering::Merge>& linkage) {
+		std::vector<double> result;
+		for (const HGCClustering::Merge& merge : linkage)
+			result.emplace_back(merge.distance);
+		std::sort(result.begin(), result.end());
+		return result;
+	};
+	check(merges.size() == reference.size() && heights(merges) == heights(reference), method + ": the lazy single linkage merges at the heights of the single linkage over the full matrix");
+}
+
+// writes the relabeling costs of the features of a synthetic dataset, growing with the distance of their indices
+std::string writeSyntheticCosts(std::size_t numberOfFeatures, std::uint32_t seed) {
+	std::string path = (std::filesystem::temp_directory_path() / ("hgc_determinism_costs_" + std::to_string(seed) + ".csv")).string();
+	std::ofstream file(path);
+	file << "feature";
+	for (std::size_t feature = 0; feature < numberOfFeatures; feature++)
+		file << ",feature_" << feature;
+	file << "\n";
+	for (std::size_t feature1 = 0; feature1 < numberOfFeatures; feature1++) {
+		file << "feature_" << feature1;
+		for (std::size_t feature2 = 0; feature2 < numberOfFeatures; feature2++)
+			file << "," << (feature1 > feature2 ? feature1 - feature2 : feature2 - feature1);
+		file << "\n";
+	}
+	return path;
+}
+
+bool isClose(double value, double expected) {
+	return std::abs(value - expected) <= 1e-6 * std::max(1.0, std::abs(expected));
+}
+
+// a computation which is cancelled keeps its completed rows, and a computation started again with the same checkpoint resumes from
+// them, also if all of its rows are restored from the checkpoint
+void testCheckpointResume(const std::string& method, const std::string& datasetPath, const std::vector<std::vector<int>>& reference) {
+	std::string checkpointPath = (std::filesystem::temp_directory_path() / "hgc_determinism.checkpoint").string();
+	std::filesystem::remove(checkpointPath);
+
+	{
+		HGCGED hgcged(method, "--threads 2", false, "LAZY");
+		hgcged.loadOmicsData(datasetPath, "", ',');
+		HGCComputeHandle handle = hgcged.startCompute(checkpointPath, 0);
+		handle.cancel();
+		handle.wait();
+		check(handle.done(), method + ": a cancelled computation is done");
+		std::vector<std::vector<int>> partial = handle.getDistanceMatrix();
+		for (std::size_t row = 0; row < partial.size(); row++) {
+			bool completed = partial.at(row) == reference.at(row);
+			bool pending = std::all_of(partial.at(row).begin(), partial.at(row).end(), [](int distance) { return distance == -1; });
+			check(completed || pending, method + ": a cancelled computation keeps only completed rows");
+		}
+	}
+
+	for (std::size_t run = 0; run < 2; run++) {
+		HGCGED hgcged(method, "--threads 2", false, "LAZY");
+		hgcged.loadOmicsData(datasetPath, "", ',');
+		HGCComputeHandle handle = hgcged.startCompute(checkpointPath, 0);
+		handle.wait();
+		check(handle.done() && !hgcged.isComputeRunning(), method + ": a resumed computation is done once it is waited for");
+		check(hgcged.getDistanceMatrix() == reference, method + (run == 0 ? ": resuming a cancelled computation" : ": restoring all rows from the checkpoint") + " returns the matrix of the synchronous computation");
+	}
+	std::filesystem::remove(checkpointPath);
+}
+
+// the mapped matrix has to hold the upper triangle of the matrix in memory and mark itself complete only once all pairs are written
+void testMappedMatrix(const std::string& method, const std::string& datasetPath, const std::vector<std::vector<int>>& reference) {
+	std::string mappedPath = (std::filesystem::temp_directory_path() / "hgc_determinism.mapped").string();
+	auto readMatrix = [&mappedPath](HGCMappedMatrix::Header& header) {
+		std::ifstream file(mappedPath, std::ios::binary);
+		file.read(reinterpret_cast<char*>(&header), sizeof(header));
+		std::size_t numberOfPairs = header.numberOfGraphs < 2 ? 0 : header.numberOfGraphs * (header.numberOfGraphs - 1) / 2;
+		std::vector<std::int32_t> distances(numberOfPairs);
+		file.seekg(static_cast<std::streamoff>(header.dataOffset));
+		file.read(reinterpret_cast<char*>(distances.data()), static_cast<std::streamsize>(numberOfPairs * sizeof(std::int32_t)));
+		return distances;
+	};
+
+	{
+		HGCMappedMatrix matrix(mappedPath, 3, 0);
+		matrix.set(0, 2, 7);
+	}
+	HGCMappedMatrix::Header header{};
+	std::vector<std::int32_t> distances = readMatrix(header);
+	check(header.complete == 0, "a mapped matrix whose pairs aren't all written isn't complete");
+	check(distances == std::vector<std::int32_t>{0, 7, 0}, "a mapped matrix stores the pairs in the condensed order");
+
+	HGCGED hgcged(method, "--threads 2", false, "LAZY");
+	hgcged.loadOmicsData(datasetPath, "", ',');
+	hgcged.computeGedsMapped(mappedPath);
+	distances = readMatrix(header);
+	check(header.complete == 1, method + ": a mapped matrix is complete once all pairs are written");
+	check(header.numberOfGraphs == reference.size(), method + ": the mapped matrix belongs to all graphs");
+	bool matching = distances.size() == reference.size() * (reference.size() - 1) / 2;
+	for (std::size_t graphId1 = 0; graphId1 < reference.size() && matching; graphId1++) {
+		for (std::size_t graphId2 = graphId1 + 1; graphId2 < reference.size(); graphId2++)
+			matching = matching && distances.at(HGCMappedMatrix::condensedIndex(reference.size(), graphId1, graphId2)) == reference.at(graphId1).at(graphId2);
+	}
+	check(matching, method + ": the mapped matrix holds the upper triangle of the matrix in memory");
+	std::filesystem::remove(mappedPath);
+}
+
+// rescoring the edit paths under the factors they were solved with has to return the distances of solving the pairs directly, and
+// solving the pairs again under every setting can only lower the rescored distances to the direct ones
+void testCostSweep(const std::string& method, const std::string& datasetPath, const std::string& costsPath) {
+	std::vector<std::pair<double, double>> settings = {{0.5, 0.5}, {0.8, 0.3}, {0.2, 0.9}};
+	HGCGED hgcged(method, "--threads 2", false, "LAZY");
+	hgcged.loadOmicsData(datasetPath, costsPath, ',');
+	std::size_t numberOfGraphs = hgcged.getNumberOfGraphs();
+	std::vector<double> rescored = hgcged.computeCostSweep(settings, -1.0);
+	std::vector<double> resolved = hgcged.computeCostSweep(settings, 0.0);
+	check(hgcged.getCostSweepStatistics().at("solved pairs") >= numberOfGraphs * (numberOfGraphs - 1) / 2, method + ": the cost sweep solves every pair once");
+
+	std::vector<std::pair<std::size_t, std::size_t>> pairs;
+	for (std::size_t graphId1 = 0; graphId1 < numberOfGraphs; graphId1++) {
+		for (std::size_t graphId2 = graphId1 + 1; graphId2 < numberOfGraphs; graphId2++)
+			pairs.emplace_back(graphId1, graphId2);
+	}
+	for (std::size_t setting = 0; setting < settings.size(); setting++) {
+		HGCGED direct(method, "--threads 2", false, "LAZY");
+		direct.loadOmicsData(datasetPath, costsPath, ',');
+		direct.setCostFactors(settings.at(setting).first, settings.at(setting).second);
+		std::vector<double> distances = direct.computeGedsPairs(pairs);
+
+		std::size_t offset = setting * numberOfGraphs * numberOfGraphs;
+		bool rescoredMatches = true;
+		bool resolvedBelow = true;
+		bool symmetric = true;
+		for (std::size_t index = 0; index < pairs.size(); index++) {
+			std::size_t upper = offset + pairs.at(index).first * numberOfGraphs + pairs.at(index).second;
+			std::size_t lower = offset + pairs.at(index).second * numberOfGraphs + pairs.at(index).first;
+			rescoredMatches = rescoredMatches && isClose(rescored.at(upper), distances.at(index));
+			resolvedBelow = resolvedBelow && resolved.at(upper) <= distances.at(index) + 1e-6 * std::max(1.0, distances.at(index)) && resolved.at(upper) <= rescored.at(upper);
+			symmetric = symmetric && rescored.at(upper) == rescored.at(lower) && resolved.at(upper) == resolved.at(lower);
+		}
+		if (setting == 0)
+			check(rescoredMatches, method + ": rescoring under the factors the pairs were solved with returns the direct distances");
+		check(resolvedBelow, method + ": solving the pairs again under a setting doesn't exceed the direct distances");
+		check(symmetric, method + ": the cost sweep returns symmetric matrices");
+	}
+}
+
+// two groups of graphs which are close within and far apart between them. every resample separates them, so the merges which form
+// the groups have a support of 1 and the graphs are co-clustered exactly with their group.
+void testBootstrapSupport() {
+	std::size_t numberOfGraphs = 8;
+	std::vector<std::vector<int>> matrix(numberOfGraphs, std::vector<int>(numberOfGraphs));
+	for (std::size_t graphId1 = 0; graphId1 < numberOfGraphs; graphId1++) {
+		for (std::size_t graphId2 = 0; graphId2 < numberOfGraphs; graphId2++)
+			matrix.at(graphId1).at(graphId2) = graphId1 == graphId2 ? 0 : (graphId1 < 4) == (graphId2 < 4) ? 1 : 20;
+	}
+
+	for (const std::string mode : {"bootstrap", "jackknife"}) {
+		std::vector<HGCClustering::Merge> reference = HGCClustering::linkage(HGCClustering::rowDistances(matrix, 1), numberOfGraphs, "average");
+		HGCBootstrap::Result result = HGCBootstrap::run(matrix, reference, "average", mode, 50, 0.75, 2, 7, 2);
+		for (std::size_t step = 0; step < reference.size(); step++) {
+			if (reference.at(step).size == 4)
+				check(result.support.at(step) == 1.0, mode + ": the merges forming the separable groups have a support of 1");
+		}
+		for (std::size_t graphId1 = 0; graphId1 < numberOfGraphs; graphId1++) {
+			for (std::size_t graphId2 = 0; graphId2 < numberOfGraphs; graphId2++) {
+				double frequency = result.coClustering.at(graphId1).at(graphId2);
+				if (frequency >= 0)
+					check(frequency == ((graphId1 < 4) == (graphId2 < 4) ? 1.0 : 0.0), mode + ": the graphs are co-clustered exactly with their group");
+			}
+		}
+	}
+}
+
+// the exact leaf ordering has to reach the minimum of the sum of the distances between adjacent leaves over all orders which the
+// dendrogram allows, found by flipping every merge of small random trees
+void testLeafOrdering(std::size_t numberOfTrees) {
+	std::mt19937 generator(11);
+	std::uniform_real_distribution<double> distribution(0.0, 1.0);
+	for (std::size_t tree = 0; tree < numberOfTrees; tree++) {
+		std::size_t numberOfLeaves = 2 + tree % 7;
+		std::vector<double> condensed(numberOfLeaves * (numberOfLeaves - 1) / 2);
+		for (double& value : condensed)
+			value = distribution(generator);
+		std::vector<HGCClustering::Merge> merges = HGCClustering::linkage(condensed, numberOfLeaves, tree % 2 == 0 ? "average" : "single");
+		std::vector<std::vector<double>> distances(numberOfLeaves, std::vector<double>(numberOfLeaves, 0));
+		for (std::size_t leaf1 = 0; leaf1 < numberOfLeaves; leaf1++) {
+			for (std::size_t leaf2 = leaf1 + 1; leaf2 < numberOfLeaves; leaf2++)
+				distances.at(leaf1).at(leaf2) = distances.at(leaf2).at(leaf1) = distribution(generator);
+		}
+		auto cost = [&distances](const std::vector<std::size_t>& order) {
+			double sum = 0;
+			for (std::size_t position = 1; position < order.size(); position++)
+				sum += distances.at(order.at(position - 1)).at(order.at(position));
+			return sum;
+		};
+
+		// all orders of every node, the leaves first and the merges in their order
+		std::vector<std::vector<std::vector<std::size_t>>> orders(2 * numberOfLeaves - 1);
+		for (std::size_t leaf = 0; leaf < numberOfLeaves; leaf++)
+			orders.at(leaf) = {{leaf}};
+		for (std::size_t step = 0; step < merges.size(); step++) {
+			for (const std::vector<std::size_t>& left : orders.at(merges.at(step).cluster1)) {
+				for (const std::vector<std::size_t>& right : orders.at(merges.at(step).cluster2)) {
+					std::vector<std::size_t> order = left;
+					order.insert(order.end(), right.begin(), right.end());
+					orders.at(numberOfLeaves + step).push_back(order);
+					order = right;
+					order.insert(order.end(), left.begin(), left.end());
+					orders.at(numberOfLeaves + step).push_back(order);
+				}
+			}
+		}
+		double minimum = std::numeric_limits<double>::max();
+		for (const std::vector<std::size_t>& order : orders.back())
+			minimum = std::min(minimum, cost(order));
+
+		std::vector<std::size_t> order = HGCDendrogram::optimalLeafOrder(merges, numberOfLeaves, [&distances](std::size_t leaf1, std::size_t leaf2) {
+			return distances.at(leaf1).at(leaf2);
+		}, numberOfLeaves, 2);
+		check(std::find(orders.back().begin(), orders.back().end(), order) != orders.back().end(), "the exact leaf order is allowed by the dendrogram");
+		check(isClose(cost(order), minimum), "the exact leaf order has the minimal sum of adjacent distances of " + std::to_string(numberOfLeaves) + " leaves");
+	}
+}
+
+}
+
+int main(int argc, char* argv[]) {
+	std::size_t maximumThreads = argc > 1 ? std::stoul(argv[1]) : std::min<std::size_t>(std::max(std::thread::hardware_concurrency(), 1u), 4);
+	std::vector<std::string> methods = {"BRANCH_FAST", "BRANCH", "BRANCH_TIGHT"};
+
+	for (const std::string& method : methods) {
+		testHandCheckedGraphs(method);
+		testDeduplicatedGraphs(method);
+	}
+
+	std::size_t numberOfSamples = 24;
+	std::size_t numberOfDuplicates = 3;
+	std::string datasetPath = writeSyntheticDataset(numberOfSamples, 12, numberOfDuplicates, 42);
+	std::string costsPath = writeSyntheticCosts(12, 42);
+	std::cout << std::left << std::setw(14) << "method" << std::setw(10) << "threads" << std::setw(14) << "deduplicate" << "seconds" << std::endl;
+	for (const std::string& method : methods) {
+		testDeterminism(method, maximumThreads, datasetPath, numberOfSamples, numberOfDuplicates);
+		testSingleLinkage(method, datasetPath);
+
+		double seconds;
+		std::vector<std::vector<int>> reference = computeMatrix(method, 2, datasetPath, false, seconds);
+		testCheckpointResume(method, datasetPath, reference);
+		testMappedMatrix(method, datasetPath, reference);
+		testCostSweep(method, datasetPath, costsPath);
+	}
+	std::filesystem::remove(datasetPath);
+	std::filesystem::remove(costsPath);
+
+	testBootstrapSupport();
+	testLeafOrdering(300);
+
+	if (failures > 0) {
+		std::cout << "Determinism Test: " << failures << " checks failed!" << std::endl;
+		return EXIT_FAILURE;
+	}
+	std::cout << "Determinism Test: Success!" << std::endl;
+	return EXIT_SUCCESS;
+}
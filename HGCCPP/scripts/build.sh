@@ -6,4 +6,5 @@ make -C build/hgc/tests/ TestExecutable
 make -C build/hgc/tests/ TestGedlib
 make -C build/hgc/tests/ TestPybind
 make -C build/hgc/src/ HGCGED
+make -C build/hgc/src/ HGCGEDExec
 cd ./scripts || return
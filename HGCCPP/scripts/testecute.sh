@@ -1,6 +1,6 @@
 #./clean.sh
 cd ../
 cmake -B build/
-make -C build/hgc/src/temp/ HGCGEDExec
-./hgc/bin/HGCGEDExec
+make -C build/hgc/tests/ TestDeterminism
+./hgc/bin/TestDeterminism
 cd ./scripts || return
@@ -19,15 +19,13 @@ def _split_name(filename):
 
 # pulls a graph out of the hgcged environment and returns it as a networkx graph
 def pull_graph(hgcged, graph_id):
-    #   graph_data[0] = adjacency matrix, graph_data[1] = node labels, graph_data[2] = edge labels
+    #   graph_data[0] = edges, graph_data[1] = node labels, graph_data[2] = edge labels
     graph_data = hgcged.get_graph(graph_id)
     graph = networkx.Graph()
     for x in range(len(graph_data[1])):
         graph.add_node(x, hgc_node_label=graph_data[1][x])
-    for x in range(len(graph_data[0])):
-        for y in range(len(graph_data[0][x])):
-            if graph_data[0][x][y] == 1:
-                graph.add_edge(x, y, hgc_edge_label=graph_data[2][x, y])
+    for x, y in graph_data[0]:
+        graph.add_edge(x, y, hgc_edge_label=graph_data[2][x, y])
     return graph
 
 
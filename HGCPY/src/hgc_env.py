@@ -1,5 +1,6 @@
 import os
 import matplotlib.pyplot
+import numpy
 import scipy
 import scipy.spatial
 import scipy.cluster
@@ -11,24 +12,21 @@ import lib.HGCGED as HGCGED
 
 
 # ========== helper ==========
-def _tree_to_graphnx_rec(tree, graph, labeling):
-
-    if tree.left is not None:
-        graph.add_node(tree.left.id, hgc_label=(labeling[tree.left.id] if (tree.left.left is None and tree.left.right is None) else str(tree.left.dist)))
-        graph.add_edge(tree.id, tree.left.id)
-        _tree_to_graphnx_rec(tree.left, graph, labeling)
-
-    if tree.right is not None:
-        graph.add_node(tree.right.id, hgc_label=(labeling[tree.right.id] if (tree.right.left is None and tree.right.right is None) else str(tree.right.dist)))
-        graph.add_edge(tree.id, tree.right.id)
-        _tree_to_graphnx_rec(tree.right, graph, labeling)
-
-
-def _tree_to_graphnx(tree, labeling):
+# converts the linkage matrix into a networkx graph of the dendrogram, labeling the leaves by the labeling and the merges by their
+# distance. the nodes are added in preorder with an explicit stack, so deep dendrograms don't hit the recursion limit.
+def _linkage_to_graphnx(linkage, labeling):
+    parents, left_children, right_children, heights = [array.tolist() for array in HGCGED.dendrogram_arrays(linkage)]
     graph = networkx.Graph()
 
-    graph.add_node(tree.id, hgc_label=(labeling[tree.id] if (tree.left is None and tree.right is None) else str(tree.dist)))
-    _tree_to_graphnx_rec(tree, graph, labeling)
+    stack = [len(parents) - 1]
+    while stack:
+        node = stack.pop()
+        graph.add_node(node, hgc_label=(labeling[node] if left_children[node] < 0 else str(heights[node])))
+        if parents[node] >= 0:
+            graph.add_edge(parents[node], node)
+        if left_children[node] >= 0:
+            stack.append(right_children[node])
+            stack.append(left_children[node])
 
     return graph
 
@@ -64,6 +62,18 @@ def set_custom_edit_costs(node_ins_cost_fun_def,
                                      edge_rel_cost_fun_def)
 
 
+# opens a distance matrix file written by compute_geds_mapped read-only and returns its condensed distances as a numpy.memmap,
+# which scipy's linkage accepts directly. raises an exception if the computation which wrote the file didn't complete.
+def open_mapped_distance_matrix(path):
+    header = numpy.fromfile(path, dtype='<u8', count=6)
+    if header.size < 6 or header[0].tobytes() != b'HGCDMAT1':
+        raise Exception("\"" + path + "\" is not a HGC distance matrix file.")
+    if header[5] != 1:
+        raise Exception("The computation which wrote \"" + path + "\" didn't complete.")
+    number_of_graphs = int(header[1])
+    return numpy.memmap(path, dtype='<i4', mode='r', offset=int(header[2]), shape=(number_of_graphs * (number_of_graphs - 1) // 2,))
+
+
 class HGCEnv:
 
     #   variables
@@ -71,6 +81,8 @@ class HGCEnv:
 
     _label_list = None
     _distance_matrix = None
+    _condensed_distance_matrix = None
+    _mapped_distance_matrix_path = None
 
     _edit_costs = None
     _ged_method = None
@@ -125,21 +137,156 @@ class HGCEnv:
             self._label_list = None
         print('Done!')
 
-    # calls the compute_geds method of hgcged and saves the result
-    def compute_geds(self):
+    # calls the set_sparsification method of hgcged, which applies to subsequently loaded omics data. mode is 'none', 'top_k'
+    # (keeps the value most deviating edges per node) or 'budget' (keeps the value most deviating edges per graph).
+    def set_sparsification(self, mode='none', value=0):
+        self._hgcged.set_sparsification(mode, value)
+
+    # calls the set_feature_filter method of hgcged, which applies to subsequently loaded omics data. the samples are optionally
+    # normalized to relative abundances, then features present in less than min_prevalence (a fraction) of the samples or with a lower
+    # mean abundance than min_mean_abundance are removed, and if top_variance_features is not 0 only that many features are kept
+    def set_feature_filter(self, min_prevalence=0.0, min_mean_abundance=0.0, top_variance_features=0, relative_abundance=False):
+        self._hgcged.set_feature_filter(min_prevalence, min_mean_abundance, top_variance_features, relative_abundance)
+
+    # returns the number of features and nodes before and after the feature filter of the last loaded omics data, and the speedups of
+    # the logratio aggregates and of each solved pair in percent as modeled from these numbers (modeled_*_speedup_percent), not measured
+    def get_feature_filter_statistics(self):
+        return self._hgcged.get_feature_filter_statistics()
+
+    # returns the number of graphs, nodes and edges before and after sparsification of the last loaded omics data
+    def get_sparsification_statistics(self):
+        return self._hgcged.get_sparsification_statistics()
+
+    # calls the set_distances_only method of hgcged (keeping the node maps requires memory quadratic in the number of graphs)
+    def set_distances_only(self, distances_only=True):
+        self._hgcged.set_distances_only(distances_only)
+
+    # calls the set_deduplicate method of hgcged (identical graphs share one computed row and column)
+    def set_deduplicate(self, deduplicate=True):
+        self._hgcged.set_deduplicate(deduplicate)
+
+    # sets whether multi-threaded computations with custom edit costs evaluate them on a single thread which memoizes the results
+    # (default) instead of every solver thread calling python. disable this if the custom cost functions are not pure.
+    def set_dispatch_custom_costs(self, dispatch=True):
+        self._hgcged.set_dispatch_custom_costs(dispatch)
+
+    # limits the seconds and iterations spent on each pair by the BRANCH_TIGHT method (0 means unlimited). pairs which run out of
+    # their budget keep their best upper bound, the gaps to the lower bounds are returned by get_gap_matrix.
+    def set_pair_budget(self, seconds=0.0, iterations=0):
+        self._hgcged.set_pair_budget(seconds, iterations)
+
+    # returns the gap between the upper and lower bound of every pair of the last computation, or an empty list without a pair budget
+    def get_gap_matrix(self):
+        return self._hgcged.get_gap_matrix()
+
+    # returns the pairs of graph ids which hit the pair budget in the last computation, largest gaps first. approximate: under an
+    # iteration limit, every pair whose bounds didn't meet is listed
+    def get_budget_exceeded_pairs(self):
+        return self._hgcged.get_budget_exceeded_pairs()
+
+    # sets a csv file into which the predicted and the measured runtimes of a sample of the solved pairs are written
+    def set_schedule_log(self, path):
+        self._hgcged.set_schedule_log(path)
+
+    # calls the compute_geds method of hgcged and saves the result. if a checkpoint path is passed, the computation resumes from it.
+    def compute_geds(self, checkpoint_path='', checkpoint_interval=60):
         if self._ged_method is None:
             raise TypeError("GED method is undefined!")
 
         print('Calculating graph edit distances (using the ' + self._ged_method + ' method with ' + self._edit_costs + ' edit costs)...')
-        self._hgcged.compute_geds()
+        if checkpoint_path == '':
+            self._hgcged.compute_geds()
+        else:
+            self._hgcged.start_compute(checkpoint_path, checkpoint_interval).wait()
         self._distance_matrix = self._hgcged.get_distance_matrix()
         if len(self._distance_matrix) == 0:
             self._distance_matrix = None
         print('Done!')
 
-    # generates the clustering, using the ged matrix obtained by compute_geds, and saves it
-    def generate_clustering(self, algorithm=''):
-        if self._distance_matrix is None:
+    # computes the graph edit distances directly into a memory-mapped condensed matrix file instead of memory, for cohorts whose
+    # matrix doesn't fit into memory. the clustering then links the distances between the rows of the mapped matrix like those of the
+    # matrix in memory, mapping them into a second file next to it.
+    def compute_geds_mapped(self, path):
+        if self._ged_method is None:
+            raise TypeError("GED method is undefined!")
+
+        print('Calculating graph edit distances into "' + path + '" (using the ' + self._ged_method + ' method with ' + self._edit_costs + ' edit costs)...')
+        self._hgcged.compute_geds_mapped(path)
+        self._distance_matrix = None
+        self._condensed_distance_matrix = open_mapped_distance_matrix(path)
+        self._mapped_distance_matrix_path = path
+        print('Done!')
+
+    # calls the compute_approximate_geds method of hgcged and saves the approximate result. only the geds between the landmarks and all
+    # graphs are computed. selection is 'random', 'kcenter' or 'stratified' (by the generated labels), a dimension of 0 uses all available.
+    def compute_approximate_geds(self, number_of_landmarks, selection='kcenter', dimension=0, seed=0, materialize=True):
+        if self._ged_method is None:
+            raise TypeError("GED method is undefined!")
+
+        print('Calculating approximate graph edit distances (using ' + str(number_of_landmarks) + ' ' + selection + ' landmarks and the ' + self._ged_method + ' method with ' + self._edit_costs + ' edit costs)...')
+        self._hgcged.compute_approximate_geds(number_of_landmarks, selection, dimension, seed)
+        if materialize:
+            self._distance_matrix = self._hgcged.get_approximate_distance_matrix()
+            if len(self._distance_matrix) == 0:
+                self._distance_matrix = None
+        print('Done!')
+
+    # computes the graph edit distances of the given (graph_id_1, graph_id_2) pairs only and returns them as a numpy array
+    def compute_geds_pairs(self, pairs):
+        if self._ged_method is None:
+            raise TypeError("GED method is undefined!")
+
+        return self._hgcged.compute_geds_pairs(pairs)
+
+    # computes the graph edit distances between every query and every reference graph and returns them as a numpy array
+    # with a row per query, e.g. to place new samples into an existing cohort without recomputing its distance matrix
+    def compute_geds_block(self, query_ids, reference_ids):
+        if self._ged_method is None:
+            raise TypeError("GED method is undefined!")
+
+        return self._hgcged.compute_geds_block(query_ids, reference_ids)
+
+    # computes one distance matrix per (node_factor, ins_del_factor) setting of the edit costs of the costs dataset and returns them as
+    # a numpy array of shape (settings, graphs, graphs). every pair is solved once and its edit path is rescored for each setting. pairs
+    # whose rescored cost is more than resolve_gap (a fraction) above a size based lower bound are solved again, never if it's negative.
+    def compute_cost_sweep(self, settings, resolve_gap=-1.0):
+        if self._ged_method is None:
+            raise TypeError("GED method is undefined!")
+
+        return self._hgcged.compute_cost_sweep([(float(node_factor), float(ins_del_factor)) for node_factor, ins_del_factor in settings], resolve_gap)
+
+    # returns the number of pairs and settings of the last cost sweep and how many pairs it solved
+    def get_cost_sweep_statistics(self):
+        return self._hgcged.get_cost_sweep_statistics()
+
+    # sets the node factor and the insert/delete factor of the edit costs of a costs dataset, which both default to 0.5
+    def set_cost_factors(self, node_factor=0.5, ins_del_factor=0.5):
+        self._hgcged.set_cost_factors(node_factor, ins_del_factor)
+
+    # returns the embedding of the graphs computed by compute_approximate_geds
+    def get_embedding(self):
+        return self._hgcged.get_embedding()
+
+    # starts computing the graph edit distances in the background and returns a handle with progress(), done(), cancel(), wait() and get_distance_matrix()
+    def start_compute(self, checkpoint_path='', checkpoint_interval=60):
+        if self._ged_method is None:
+            raise TypeError("GED method is undefined!")
+
+        print('Starting to calculate graph edit distances (using the ' + self._ged_method + ' method with ' + self._edit_costs + ' edit costs)...')
+        return self._hgcged.start_compute(checkpoint_path, checkpoint_interval)
+
+    # waits for a computation started by start_compute and saves its result
+    def finish_compute(self, handle):
+        handle.wait()
+        self._distance_matrix = handle.get_distance_matrix()
+        if len(self._distance_matrix) == 0:
+            self._distance_matrix = None
+        print('Done!')
+
+    # generates the clustering, using the ged matrix obtained by compute_geds, and saves it. the leaves are ordered natively, optimally
+    # within the subtrees of at most exact_ordering_limit leaves and greedily above them.
+    def generate_clustering(self, algorithm='', exact_ordering_limit=1000):
+        if self._distance_matrix is None and self._condensed_distance_matrix is None:
             raise TypeError("Distance matrix is undefined (or empty)!")
 
         fixed_algorithm = None
@@ -171,10 +318,48 @@ class HGCEnv:
 
         self._clustering_algorithm = fixed_algorithm
         print('Generating clustering (using the ' + self._clustering_algorithm + ' method)... ', end='')
-        condensed_matrix = scipy.spatial.distance.pdist(self._distance_matrix)
-        self._clustering = scipy.cluster.hierarchy.linkage(condensed_matrix, method=self._clustering_algorithm, optimal_ordering=True)
+        if self._distance_matrix is not None:
+            condensed_matrix = scipy.spatial.distance.pdist(self._distance_matrix)
+        else:
+            # the same distances between the rows as pdist computes in memory, computed natively on the mapped matrix
+            condensed_matrix = numpy.memmap(self._mapped_distance_matrix_path + '.rows', dtype='<f8', mode='w+', shape=self._condensed_distance_matrix.shape)
+            self._hgcged.compute_row_distances(self._condensed_distance_matrix, condensed_matrix)
+        self._clustering = scipy.cluster.hierarchy.linkage(condensed_matrix, method=self._clustering_algorithm)
+        self._clustering = self._hgcged.order_leaves(self._clustering, condensed_matrix, exact_ordering_limit)
         print('Done!')
 
+    # generates a single linkage clustering directly on the graph edit distances, computing only the distances which can still be
+    # in the minimum spanning tree according to their lower bounds. doesn't need compute_geds to be called before.
+    def generate_clustering_single_linkage(self):
+        print('Generating clustering (using the single method on lazily computed graph edit distances)... ')
+        self._clustering_algorithm = 'single'
+        self._clustering = self._hgcged.compute_single_linkage()
+        statistics = self._hgcged.get_lazy_linkage_statistics()
+        print('Done! ' + str(statistics.get('avoided exact solves', 0)) + ' of ' + str(statistics.get('pairs', 0)) + ' exact solves were avoided.')
+
+    # returns the number of pairs, bound solves, exact solves and avoided exact solves of the last lazy single linkage clustering
+    def get_lazy_linkage_statistics(self):
+        return self._hgcged.get_lazy_linkage_statistics()
+
+    # cuts the clustering into the given number of clusters and counts the labels of the labeled attribute in each of them
+    def get_label_counts(self, number_of_clusters):
+        if self._clustering is None:
+            raise TypeError("Clustering is undefined!")
+        clusters = scipy.cluster.hierarchy.fcluster(self._clustering, number_of_clusters, criterion='maxclust') - 1
+        return self._hgcged.get_label_counts([int(cluster) for cluster in clusters])
+
+    # estimates the stability of the clustering by reclustering bootstrap resamples (or jackknife subsamples keeping the given fraction
+    # of the graphs) of the ged matrix, without computing any ged again. returns the support of each merge of the clustering (-1 if it
+    # couldn't be estimated) and the matrix of how often two graphs end up in the same of number_of_clusters clusters.
+    def generate_clustering_stability(self, resamples=100, mode='bootstrap', fraction=0.8, number_of_clusters=2, seed=0):
+        if self._clustering is None:
+            raise TypeError("Clustering is undefined!")
+
+        print('Generating clustering stability (using ' + str(resamples) + ' ' + mode + ' resamples)... ', end='')
+        self._hgcged.compute_clustering_stability(self._clustering_algorithm, mode, resamples, fraction, number_of_clusters, seed, self._clustering.tolist())
+        print('Done!')
+        return numpy.array(self._hgcged.get_bootstrap_support()), numpy.array(self._hgcged.get_co_clustering_frequencies())
+
     # generates the networkx graph of the clustering and saves it
     def generate_clustering_nx(self):
         if self._clustering is None:
@@ -183,8 +368,7 @@ class HGCEnv:
             self.generate_labels()
 
         print('Converting clustering to NetworkX graph... ', end='')
-        clustering_tree = scipy.cluster.hierarchy.to_tree(self._clustering)
-        self._clustering_nx = _tree_to_graphnx(clustering_tree, self._label_list)
+        self._clustering_nx = _linkage_to_graphnx(self._clustering, self._label_list)
         print('Done!')
 
     # ========== save ==========
@@ -244,15 +428,32 @@ class HGCEnv:
         networkx.write_graphml(self._clustering_nx, out_dir + 'gml/' + self._get_filename() + ".gml")
         print('Done!')
 
+    # saves the dendrogram of the clustering as a newick file, naming the leaves by their labels
+    def save_clustering_newick(self, out_dir):
+        if self._clustering is None:
+            raise TypeError("Clustering is undefined!")
+        if self._label_list is None:
+            self.generate_labels()
+
+        try:
+            os.mkdir(out_dir + 'newick/')
+        except FileExistsError:
+            pass
+        print('Saving dendrogram newick... ', end='')
+        with open(out_dir + 'newick/' + self._get_filename() + ".nwk", 'w') as file:
+            file.write(HGCGED.dendrogram_newick(self._clustering, self._label_list if self._label_list is not None else []) + '\n')
+        print('Done!')
+
     # ========== helper ==========
 
     # calls all necessary functions consecutively
-    def run_clustering_full(self, out_dir, algorithm=''):
-        self.generate_clustering(algorithm)
+    def run_clustering_full(self, out_dir, algorithm='', exact_ordering_limit=1000):
+        self.generate_clustering(algorithm, exact_ordering_limit)
         self.generate_clustering_nx()
         self.plot_clustering(out_dir, save=True, show=False)
         self.plot_clustering_nx(out_dir, save=True, show=False)
         self.save_clustering_nx_gml(out_dir)
+        self.save_clustering_newick(out_dir)
 
     # generates a filename out of the clustering and ged computation methods in use
     def _get_filename(self):
@@ -273,11 +474,51 @@ class HGCEnv:
     def get_clustering_nx(self):
         return self._clustering_nx
 
+    # returns the node map of the given pair (only available if the distances only mode was disabled during compute_geds)
+    def get_node_map(self, graph_id_1, graph_id_2):
+        return self._hgcged.get_node_map(graph_id_1, graph_id_2)
+
+    # returns the number of graphs, classes of identical graphs, the largest class size and the solved and skipped pairs of the last compute_geds call
+    def get_deduplication_statistics(self):
+        return self._hgcged.get_deduplication_statistics()
+
+    # returns the peak memory usage in bytes reached during the last compute_geds call
+    def get_peak_memory_usage(self):
+        return self._hgcged.get_peak_memory_usage()
+
+    # returns the estimated bytes of every component of the environment (omics_data, attributes, graphs_estimate, snapshots, edit_costs,
+    # solver_contexts, distance_matrix, node_maps, gap_matrix), their total and the measured resident and peak resident bytes. gedlib
+    # doesn't report the memory of its graphs, so graphs_estimate is modeled from the numbers of nodes and edges.
+    def get_memory_usage(self):
+        return self._hgcged.get_memory_usage()
+
+    # sets the bytes which loading and computing may use (0 means unlimited). exceeding it raises an error before allocating.
+    def set_memory_budget(self, budget_bytes=0):
+        self._hgcged.set_memory_budget(budget_bytes)
+
+    # ========== tracing ==========
+
+    # enables or disables recording trace spans (only available if HGCGED was built with HGC_ENABLE_TRACING)
+    def set_tracing(self, enabled=True):
+        self._hgcged.set_tracing(enabled)
+
+    # prints a table of the count and the total, mean and maximum duration of every traced span
+    def print_trace_summary(self):
+        print(self._hgcged.get_trace_summary())
+
+    # writes the traced spans into a json file which can be opened in chrome://tracing or perfetto
+    def write_trace(self, path):
+        self._hgcged.write_trace(path)
+
     # ========== export & import ==========
 
     def pull_graph(self, graph_id):
         return glnx_parser.pull_graph(self._hgcged, graph_id)
 
+    # returns the ids of all graphs with the given name
+    def get_graph_ids(self, name):
+        return self._hgcged.get_graph_ids(name)
+
     def push_graph(self, graph, name, node_label_key='', edge_label_key=''):
         if node_label_key == '':
             print("No node label key passed. Defaulting to \"hgc_node_label\".")
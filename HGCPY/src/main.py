@@ -17,6 +17,15 @@ cluster_algorithm = None
 ged_method = None
 method_arguments = None
 init_type = None
+checkpoint_path = None
+sparsification_mode = None
+sparsification_value = None
+min_prevalence = None
+min_mean_abundance = None
+top_variance_features = None
+relative_abundance = None
+memory_budget = None
+exact_ordering_limit = None
 
 
 #   USER COST FUNCTIONS -------------------------------
@@ -70,7 +79,16 @@ def parse_arguments(raw_arguments):
                    "\t[-cluster_algo nearest_point|farthest_point|upgma|wpgma|upgmc|wpgmc|incremental]\n" \
                    "\t[-ged_method SUPER_FAST|FAST|TIGHT]\n" \
                    "\t[--<method-option> <method-arg>] [...]\n" \
-                   "\t[-init_type LAZY|EAGER]\n" \
+                   "\t[-init_type LAZY (EAGER is deprecated and ignored)]\n" \
+                   "\t[-checkpoint <path-to-checkpoint-file>]\n" \
+                   "\t[-edge_top_k <edges-per-node>]\n" \
+                   "\t[-edge_budget <edges-per-graph>]\n" \
+                   "\t[-min_prevalence <fraction-of-samples>]\n" \
+                   "\t[-min_mean_abundance <abundance>]\n" \
+                   "\t[-top_variance_features <features>]\n" \
+                   "\t[-relative_abundance yes|no]\n" \
+                   "\t[-memory_budget <mebibytes>]\n" \
+                   "\t[-exact_ordering_limit <leaves>]\n" \
                    "If GML data is specified, CSV data can be omitted, and vice-versa." \
 
     global out_path
@@ -99,6 +117,24 @@ def parse_arguments(raw_arguments):
     method_arguments = ''
     global init_type
     init_type = ''
+    global checkpoint_path
+    checkpoint_path = ''
+    global sparsification_mode
+    sparsification_mode = 'none'
+    global sparsification_value
+    sparsification_value = 0
+    global min_prevalence
+    min_prevalence = 0.0
+    global min_mean_abundance
+    min_mean_abundance = 0.0
+    global top_variance_features
+    top_variance_features = 0
+    global relative_abundance
+    relative_abundance = False
+    global memory_budget
+    memory_budget = 0
+    global exact_ordering_limit
+    exact_ordering_limit = 1000
 
     if len(raw_arguments) < 2:
         print(usage_string)
@@ -140,6 +176,26 @@ def parse_arguments(raw_arguments):
                         method_arguments += raw_arguments[c] + " " + raw_arguments[c + 1]
                     elif raw_arguments[c][1:] == "init_type":
                         init_type = raw_arguments[c + 1]
+                    elif raw_arguments[c][1:] == "checkpoint":
+                        checkpoint_path = raw_arguments[c + 1]
+                    elif raw_arguments[c][1:] == "edge_top_k":
+                        sparsification_mode = 'top_k'
+                        sparsification_value = int(raw_arguments[c + 1])
+                    elif raw_arguments[c][1:] == "edge_budget":
+                        sparsification_mode = 'budget'
+                        sparsification_value = int(raw_arguments[c + 1])
+                    elif raw_arguments[c][1:] == "min_prevalence":
+                        min_prevalence = float(raw_arguments[c + 1])
+                    elif raw_arguments[c][1:] == "min_mean_abundance":
+                        min_mean_abundance = float(raw_arguments[c + 1])
+                    elif raw_arguments[c][1:] == "top_variance_features":
+                        top_variance_features = int(raw_arguments[c + 1])
+                    elif raw_arguments[c][1:] == "relative_abundance":
+                        relative_abundance = raw_arguments[c + 1] == "yes"
+                    elif raw_arguments[c][1:] == "memory_budget":
+                        memory_budget = int(raw_arguments[c + 1]) * 1024 * 1024
+                    elif raw_arguments[c][1:] == "exact_ordering_limit":
+                        exact_ordering_limit = int(raw_arguments[c + 1])
                     else:
                         raise Exception("Invalid option \"" + raw_arguments[c][1:] + "\".\n" + usage_string)
                     c += 1
@@ -207,9 +263,12 @@ def run():
 
     #   construct
     hgc = hgc_env.HGCEnv(ged_method, method_arguments, True if edit_costs == "custom" else False, init_type)
+    hgc.set_memory_budget(memory_budget)
 
     #   csv
     if csv_omics_path != '':
+        hgc.set_sparsification(sparsification_mode, sparsification_value)
+        hgc.set_feature_filter(min_prevalence, min_mean_abundance, top_variance_features, relative_abundance)
         hgc.load_csv(csv_omics_path, csv_clinical_path, csv_distances_path, True if edit_costs == "auto" else False)
 
     #   gml
@@ -220,10 +279,10 @@ def run():
     hgc.generate_labels(labeled_attribute)
 
     #   ged
-    hgc.compute_geds()
+    hgc.compute_geds(checkpoint_path)
 
     #   cluster
-    hgc.run_clustering_full(out_path, cluster_algorithm)
+    hgc.run_clustering_full(out_path, cluster_algorithm, exact_ordering_limit)
 
 
 run()